@@ -20,6 +20,26 @@ public:
 	virtual void setDirtSensor(const DirtSensor&) = 0;
 	virtual void setBatteryMeter(const BatteryMeter&) = 0;
 	virtual Step nextStep() = 0;
+
+	/*
+		Optional: fills steps with a committed plan of up to maxSteps next steps, returning how many. The sensors
+		are only refreshed before each plan, so every step after the first must not depend on reading them. By
+		default a plan is the single next step.
+	*/
+	virtual size_t nextSteps(Step* steps, size_t maxSteps) {
+		if(maxSteps == 0)
+			return 0;
+		steps[0] = nextStep();
+		return 1;
+	}
+
+	/*
+		Optional: after a plan ending in a Stay, commits to repeating that Stay up to maxStays more times and
+		returns how many, so the simulator can apply them all at once. By default the Stay is not repeated.
+	*/
+	virtual size_t repeatStay(size_t /*maxStays*/) {
+		return 0;
+	}
 };
     
 #endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef BENCH_HOUSES_H
+#define BENCH_HOUSES_H
+
+#include <string>
+#include "house_generator.h"
+
+/**
+ * @brief A class declaration for building deterministic houses to benchmark against.
+ *
+ * The "BenchHouses" class builds square houses of a given shape and side length in memory with the house
+ * generator and fixed options, so that results are comparable across commits. Houses are written and shapes are
+ * named with the generator's own helpers.
+ */
+class BenchHouses {
+public:
+    /**
+     * @brief Builds a square house, surrounded by walls, with the charging dock in its top-left corner.
+     * @param shape The shape of the house.
+     * @param size The side length of the house, including its outer walls.
+     * @return The house, with a mission budget and battery large enough to explore it.
+     */
+    static HouseLayout make(const HouseStyle shape, const int size);
+
+    /**
+     * @brief Gets a path within the temporary directory for benchmark files.
+     * @param name The file name.
+     * @return The path.
+     */
+    static std::string tempPath(const std::string name);
+};
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <ctime>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A class declaration for the state handed to a running benchmark.
+ *
+ * The "BenchmarkState" class follows the Google Benchmark model: the benchmark function loops on keepRunning(),
+ * and only the time spent inside the loop (minus any paused sections) is measured. The harness decides how many
+ * iterations to run, calling the function again with more iterations until the minimum time is reached.
+ */
+class BenchmarkState {
+public:
+    /**
+     * @brief Constructs a "BenchmarkState" object.
+     * @param iterations The number of iterations to run.
+     * @param args The arguments of the benchmark instance.
+     */
+    BenchmarkState(std::int64_t iterations, std::vector<std::int64_t> args)
+        : iterations(iterations), remaining(iterations), args(args), started(false), paused(false),
+          realNs(0), cpuNs(0), itemsProcessed(0), bytesProcessed(0) {}
+
+    /**
+     * @brief Destroys a "BenchmarkState" object.
+     */
+    ~BenchmarkState() {}
+
+    /**
+     * @brief Starts timing on the first call, and stops it once every iteration has run.
+     * @return true if another iteration should run, otherwise false.
+     */
+    bool keepRunning();
+
+    /**
+     * @brief Stops timing until resumeTiming() is called, e.g. around per-iteration setup.
+     */
+    void pauseTiming();
+
+    /**
+     * @brief Resumes timing after pauseTiming().
+     */
+    void resumeTiming();
+
+    /**
+     * @brief Gets the specified argument of the benchmark instance.
+     * @param index The index of the argument.
+     * @return The argument.
+     */
+    std::int64_t range(std::size_t index) const;
+
+    /**
+     * @brief Gets the number of iterations run.
+     * @return The number of iterations.
+     */
+    std::int64_t getIterations() const;
+
+    /**
+     * @brief Sets the total number of items processed over all iterations, reported as items_per_second.
+     */
+    void setItemsProcessed(std::int64_t items);
+
+    /**
+     * @brief Sets the total number of bytes processed over all iterations, reported as bytes_per_second.
+     */
+    void setBytesProcessed(std::int64_t bytes);
+
+    /**
+     * @brief Sets a free-form label reported with the results.
+     */
+    void setLabel(std::string label);
+
+    std::map<std::string, double> counters;   // User counters, reported as-is.
+
+private:
+    friend class BenchmarkRunner;
+
+    std::int64_t iterations;             // The number of iterations to run.
+    std::int64_t remaining;              // The number of iterations left to run.
+    std::vector<std::int64_t> args;      // The arguments of the benchmark instance.
+    bool started;                        // Whether timing has started.
+    bool paused;                         // Whether timing is paused.
+
+    std::chrono::steady_clock::time_point realStart; // Start of the current timed section, wall clock.
+    std::int64_t cpuStart;               // Start of the current timed section, thread CPU clock (ns).
+    std::int64_t realNs;                 // Wall time accumulated over timed sections.
+    std::int64_t cpuNs;                  // Thread CPU time accumulated over timed sections.
+
+    std::int64_t itemsProcessed;         // Items processed over all iterations.
+    std::int64_t bytesProcessed;         // Bytes processed over all iterations.
+    std::string label;                   // Free-form label.
+
+    /**
+     * @brief Gets the CPU time consumed by the calling thread.
+     * @return The CPU time, in nanoseconds.
+     */
+    static std::int64_t threadCpuNs();
+};
+
+/**
+ * @brief A class declaration for a registered benchmark function and the argument sets it runs with.
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Constructs a "Benchmark" object.
+     * @param name The name of the benchmark.
+     * @param fn The benchmark function.
+     */
+    Benchmark(std::string name, std::function<void(BenchmarkState&)> fn) : name(name), fn(fn) {}
+
+    /**
+     * @brief Adds an instance of the benchmark run with a single argument.
+     * @return This benchmark, for chaining.
+     */
+    Benchmark* arg(std::int64_t a);
+
+    /**
+     * @brief Adds an instance of the benchmark run with several arguments.
+     * @return This benchmark, for chaining.
+     */
+    Benchmark* args(std::vector<std::int64_t> a);
+
+    /**
+     * @brief Names the arguments, so instances are reported as "name/argName:value/...".
+     * @return This benchmark, for chaining.
+     */
+    Benchmark* argNames(std::vector<std::string> names);
+
+private:
+    friend class BenchmarkRunner;
+
+    std::string name;                                  // The name of the benchmark.
+    std::function<void(BenchmarkState&)> fn;           // The benchmark function.
+    std::vector<std::vector<std::int64_t>> instances;  // The argument set of each instance.
+    std::vector<std::string> names;                    // The name of each argument.
+};
+
+/**
+ * @brief A class declaration for running every registered benchmark and reporting results.
+ *
+ * Results are printed as a console table, or as JSON in the Google Benchmark schema so that existing comparison
+ * tooling can diff runs across commits.
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * @brief Registers a benchmark function.
+     * @param name The name of the benchmark.
+     * @param fn The benchmark function.
+     * @return The registered benchmark, to add instances to.
+     */
+    static Benchmark* registerBenchmark(std::string name, std::function<void(BenchmarkState&)> fn);
+
+    /**
+     * @brief Parses the command line and runs every matching benchmark.
+     * @return The process exit code.
+     */
+    static int main(int argc, char** argv);
+
+private:
+    /**
+     * @brief A struct declaration for the measured result of one benchmark instance.
+     */
+    struct Result {
+        std::string name;                      // The name of the instance.
+        std::int64_t iterations;               // The number of iterations measured.
+        double realNs;                         // Wall time per iteration.
+        double cpuNs;                          // Thread CPU time per iteration.
+        double itemsPerSecond;                 // Items processed per second, or 0.
+        double bytesPerSecond;                 // Bytes processed per second, or 0.
+        std::string label;                     // Free-form label.
+        std::map<std::string, double> counters;// User counters.
+    };
+
+    /**
+     * @brief Gets every registered benchmark.
+     */
+    static std::deque<Benchmark>& registry();
+
+    /**
+     * @brief Runs a benchmark instance until it has been measured for at least the minimum time.
+     */
+    static Result runInstance(const Benchmark& b, const std::vector<std::int64_t>& args, std::string name, double minTime);
+
+    /**
+     * @brief Writes results as Google Benchmark JSON.
+     */
+    static void writeJson(std::ostream& out, const std::vector<Result>& results);
+
+    /**
+     * @brief Writes results as a console table.
+     */
+    static void writeConsole(std::ostream& out, const std::vector<Result>& results);
+};
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+
+/**
+ * @brief Registers a benchmark function at static initialization, e.g. BENCHMARK(BM_Foo)->arg(64);
+ */
+#define BENCHMARK(fn) \
+    static Benchmark* BENCHMARK_CONCAT(benchmark_, __LINE__) = BenchmarkRunner::registerBenchmark(#fn, fn)
+
+#endif
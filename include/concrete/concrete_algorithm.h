@@ -1,33 +1,33 @@
 #ifndef CONCRETE_ALGORITHM_H
 #define CONCRETE_ALGORITHM_H
 
-#include <unordered_map>
-#include <unordered_set>
-#include <queue>
-#include <stack>
-#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 #include <limits>
 #include "abstract_algorithm.h"
-#include "concrete_battery_meter.h"
-#include "concrete_dirt_sensor.h"
-#include "concrete_walls_sensor.h"
 #include "coordinate.h"
-#include "hash.h"
-#include "node.h"
+#include "coordinate_map.h"
+#include "instrumentation.h"
+#include "node_map.h"
+#include "node_set.h"
+#include "perf_profiler.h"
+#include "trace_writer.h"
 
 
 /**
  * @brief The concrete implementation of the abstract class "AbstractAlgorithm".
  * 
  * The "ConcreteAlgorithm" class provides an API to the simulator for initializing the sensors
- * it will request data from, and calculates the robot's traversal. 
+ * it will request data from, and calculates the robot's traversal. Sensors are read through their
+ * abstract interfaces, see "SpecializedAlgorithm" for reading sensors of known types directly.
  */
 class ConcreteAlgorithm : public AbstractAlgorithm {
 public:
     /**
      * @brief Constructs a "ConcreteAlgorithm" object.
      */
-    ConcreteAlgorithm() : stepCount(0), robotCoords(Coordinate(0, 0)), distFromDock(0) {}
+    ConcreteAlgorithm() : stepCount(0), robotCoords(Coordinate(0, 0)), searchGeneration(0), profiler(nullptr), tracer(nullptr) {}
 
     /**
      * @brief Destroys a "ConcreteAlgorithm" object.
@@ -57,6 +57,18 @@ public:
      * @param wallsSensor A reference to the WallsSensor.
      */
     void setWallsSensor(const WallsSensor& wallsSensor);
+
+    /**
+     * @brief Stores the profiler to attribute hardware counters of the planner's searches to.
+     * @param profiler The profiler, or nullptr to not profile.
+     */
+    void setProfiler(PerfProfiler* profiler);
+
+    /**
+     * @brief Stores the trace writer to record each replan of the planner to, tagged with its step.
+     * @param tracer The trace writer, or nullptr to not trace.
+     */
+    void setTracer(TraceWriter* tracer);
     
     /**
      * @brief Calculates the next step the robot should take based on pertinent data.
@@ -64,35 +76,89 @@ public:
      */
     Step nextStep();
 
+    /**
+     * @brief Calculates a committed plan of the next steps the robot should take. After the first step, the plan
+     * carries on for as long as the robot moves onto visited spaces, whose walls and dirt are already mapped and
+     * whose battery follows from the steps taken, so the sensors would only read back what is already known.
+     * The plan ends at the first Stay, which repeatStay() can go on with. The plan is exactly the steps
+     * successive calls to nextStep() would return.
+     * @param steps The span to fill with the plan.
+     * @param maxSteps The most steps to plan, no more than the steps left in the mission budget.
+     * @return The number of steps planned, at least 1 unless maxSteps is 0.
+     */
+    size_t nextSteps(Step* steps, const size_t maxSteps);
+
+    /**
+     * @brief Calculates, in closed form, how many more times the robot should repeat the Stay it was just given:
+     * charging goes on until the battery is full, and cleaning until the space is clean or the battery or
+     * budget are only just enough to return. The stays are taken as if returned by as many calls to nextStep().
+     * @param maxStays The most stays to take, no more than the steps left in the mission budget.
+     * @return The number of stays taken.
+     */
+    size_t repeatStay(const size_t maxStays);
+
+#ifdef ROBOT_INSTRUMENT
+    /**
+     * @brief Gets the counters kept over the mission so far.
+     * @return The counters.
+     */
+    const AlgorithmStats& getStats() const;
+#endif
+
+protected:
+    /* Last sensor readings, pulled by setup() or by a specialization. */
+    int batteryLeft;
+    int dirt;
+    bool wallNorth, wallWest, wallSouth, wallEast;
+
+    void updateMap();
+    Step computeStep();
+    size_t planSteps(Step* steps, const size_t maxSteps);
+
 private:
+    friend class PlannerBench;                                                    // Benchmarks the searches directly.
+
     size_t missionBudget;                                                         // The number of steps allocated to the robot for the mission.
     const BatteryMeter* bm;
     const DirtSensor* ds;
     const WallsSensor* ws;
 
-    int batteryLeft;
-    int dirt;
-    bool wallNorth, wallWest, wallSouth, wallEast;
-
     /* Maintained by algorithm. */
     int batteryCap;
     int stepCount;                                                                // Maintains number of steps taken.
     Coordinate robotCoords;                                                       // Maintains current robot position.
-    int distFromDock;                                                             // An estimation of how far the robot is from the dock.
 
-    std::unordered_map<Coordinate, std::shared_ptr<Node>, cHash> houseMap;        // Maps coordinates to a node object.
-    std::unordered_set<std::shared_ptr<Node>, nHash> unvisitedNodes;              // Nodes to explore next.
-    std::stack<std::shared_ptr<Node>> pathToDock;                                 // Empty when not in use, otherwise the robot must follow this path under any circumstance.
-    std::stack<std::shared_ptr<Node>> pathToNode;                                 // Empty when not in use, otherwise the robot will follow this path if pathToDock is not set. 
+    NodeMap nodes;                                                                // Mapped nodes, indexed by node ID.
+    CoordinateMap<NodeId> houseMap;                                               // Maps coordinates to a node ID.
+    NodeSet unvisitedNodes;                                                       // Nodes to explore next.
+    std::vector<NodeId> pathToDock;                                               // Stack (next node at the back). Empty when not in use, otherwise the robot must follow this path under any circumstance.
+    std::vector<NodeId> pathToNode;                                               // Stack (next node at the back). Empty when not in use, otherwise the robot will follow this path if pathToDock is not set. 
+
+    /* Scratch buffers reused by every search, sized to the number of mapped nodes. */
+    std::vector<std::uint32_t> searchStamp;                                       // Generation of the search that last reached each node.
+    std::vector<NodeId> searchParent;                                             // Node each node was reached from in the last search.
+    std::vector<NodeId> searchQueue;                                              // Flat FIFO queue; each node is queued at most once per search.
+    std::uint32_t searchGeneration;                                               // Generation of the current search.
+
+    PerfProfiler* profiler;                                                       // Profiler of the planner's searches, or nullptr.
+    TraceWriter* tracer;                                                          // Timeline of the planner's replans, or nullptr.
+
+#ifdef ROBOT_INSTRUMENT
+    AlgorithmStats stats;                                                         // Counters kept over the mission.
+#endif
 
     void setup();
+    bool predictSensors(Step s);
     bool onChargingDock();
     void markSurroundings();
-    void mapNeighbor(Coordinate coords);
-    std::shared_ptr<Node> getClosestAdjacentNode();
+    void mapNeighbor(Coordinate coords, Direction d);
+    NodeId addNode(Coordinate coords);
+    std::uint32_t beginSearch();
+    NodeId getClosestAdjacentNode();
     void setClosestNonAdjacentNodePath();
-    Step getDirectionToNode(std::shared_ptr<Node> node);
-    std::stack<std::shared_ptr<Node>> findShortestPath(std::shared_ptr<Node> start, std::shared_ptr<Node> end);
+    Step getDirectionToNode(NodeId node);
+    void updateDistFromDock(NodeId a, NodeId b);
+    void findPathToDock(NodeId start, std::vector<NodeId>& path);
     Step returnToDock();
     Step moveToNode();
 };
@@ -25,7 +25,7 @@ public:
      * @brief Gets the remaining battery of the robot.
      * @return The remaining battery as a size_t.
      */
-    size_t getBatteryState() const;
+    inline size_t getBatteryState() const { return this->batteryState; }
 
     /**
      * @brief Updates the remaining battery of the robot.
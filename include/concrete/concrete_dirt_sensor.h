@@ -25,7 +25,7 @@ public:
      * @brief Gets the dirt level at the robot's current location.
      * @return The dirt level as an int.
      */
-    int dirtLevel() const;
+    inline int dirtLevel() const { return this->dirt; }
 
     /**
      * @brief Updates the dirt level at the robot's current location.
@@ -26,7 +26,15 @@ public:
      * @param d The specified direction to check.
      * @return Whether or not there is a wall. 
      */
-    bool isWall(Direction d) const;
+    inline bool isWall(Direction d) const {
+        if(d == Direction::North) 
+            return this->wallNorth;
+        if(d == Direction::West)
+            return this->wallWest;
+        if(d == Direction::South)
+            return this->wallSouth;
+        return this->wallEast;
+    }
 
     /**
      * @brief Updates the presence of a wall in the specified direction from the robot.
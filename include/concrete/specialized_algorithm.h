@@ -0,0 +1,108 @@
+#ifndef SPECIALIZED_ALGORITHM_H
+#define SPECIALIZED_ALGORITHM_H
+
+#include "concrete_algorithm.h"
+#include "concrete_battery_meter.h"
+#include "concrete_dirt_sensor.h"
+#include "concrete_walls_sensor.h"
+
+/**
+ * @brief A "ConcreteAlgorithm" specialized for sensors whose types are known at compile time.
+ *
+ * The "SpecializedAlgorithm" class template plans exactly as "ConcreteAlgorithm" does, but keeps its sensors as
+ * pointers to their concrete types and reads them with non-virtual calls, which inline to direct member loads for
+ * sensors that define their getters in their headers. The sensors it is given must be of the types it is
+ * specialized for, as with those of a "Simulation" of the same types.
+ *
+ * @tparam BM The type of the battery meter.
+ * @tparam DS The type of the dirt sensor.
+ * @tparam WS The type of the walls sensor.
+ */
+template <typename BM, typename DS, typename WS>
+class SpecializedAlgorithm : public ConcreteAlgorithm {
+public:
+    /**
+     * @brief Constructs a "SpecializedAlgorithm" object.
+     */
+    SpecializedAlgorithm() : batteryMeter(nullptr), dirtSensor(nullptr), wallsSensor(nullptr) {}
+
+    /**
+     * @brief Destroys a "SpecializedAlgorithm" object.
+     */
+    virtual ~SpecializedAlgorithm() {}
+
+    /**
+     * @brief Stores the location of the BatteryMeter for future data requests.
+     * @param batteryMeter A reference to the BatteryMeter, which must be a BM.
+     */
+    void setBatteryMeter(const BatteryMeter& batteryMeter) {
+        ConcreteAlgorithm::setBatteryMeter(batteryMeter);
+        this->batteryMeter = static_cast<const BM*>(&batteryMeter);
+    }
+
+    /**
+     * @brief Stores the location of the DirtSensor for future data requests.
+     * @param dirtSensor A reference to the DirtSensor, which must be a DS.
+     */
+    void setDirtSensor(const DirtSensor& dirtSensor) {
+        ConcreteAlgorithm::setDirtSensor(dirtSensor);
+        this->dirtSensor = static_cast<const DS*>(&dirtSensor);
+    }
+
+    /**
+     * @brief Stores the location of the WallsSensor for future data requests.
+     * @param wallsSensor A reference to the WallsSensor, which must be a WS.
+     */
+    void setWallsSensor(const WallsSensor& wallsSensor) {
+        ConcreteAlgorithm::setWallsSensor(wallsSensor);
+        this->wallsSensor = static_cast<const WS*>(&wallsSensor);
+    }
+
+    /**
+     * @brief Calculates the next step the robot should take based on pertinent data.
+     * @return The next step the robot should take.
+     */
+    Step nextStep() {
+        readSensors();
+        updateMap();
+        return computeStep();
+    }
+
+    /**
+     * @brief Calculates a committed plan of the next steps the robot should take, as "ConcreteAlgorithm" does.
+     * @param steps The span to fill with the plan.
+     * @param maxSteps The most steps to plan, no more than the steps left in the mission budget.
+     * @return The number of steps planned, at least 1 unless maxSteps is 0.
+     */
+    size_t nextSteps(Step* steps, const size_t maxSteps) {
+        if(maxSteps == 0)
+            return 0;
+        readSensors();
+        updateMap();
+        return planSteps(steps, maxSteps);
+    }
+
+private:
+    const BM* batteryMeter;     // The battery meter, as its concrete type.
+    const DS* dirtSensor;       // The dirt sensor, as its concrete type.
+    const WS* wallsSensor;      // The walls sensor, as its concrete type.
+
+    /**
+     * @brief Pulls data from the sensors. Qualified calls bind statically, even to getters that are virtual.
+     */
+    void readSensors() {
+        this->batteryLeft = this->batteryMeter->BM::getBatteryState();
+        this->dirt = this->dirtSensor->DS::dirtLevel();
+        this->wallNorth = this->wallsSensor->WS::isWall(Direction::North);
+        this->wallWest = this->wallsSensor->WS::isWall(Direction::West);
+        this->wallSouth = this->wallsSensor->WS::isWall(Direction::South);
+        this->wallEast = this->wallsSensor->WS::isWall(Direction::East);
+    }
+};
+
+/**
+ * @brief The algorithm specialized for the simulator's own sensors.
+ */
+using ConcreteSpecializedAlgorithm = SpecializedAlgorithm<ConcreteBatteryMeter, ConcreteDirtSensor, ConcreteWallsSensor>;
+
+#endif
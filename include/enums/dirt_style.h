@@ -0,0 +1,11 @@
+#ifndef DIRT_STYLE_H
+#define DIRT_STYLE_H
+
+/**
+ * @brief An enum class declaration for the dirt distribution of generated houses.
+ * 
+ * Use this enum when choosing how dirt is spread by the house generator.
+ */
+enum class DirtStyle { None, Uniform, Clustered };
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef HOUSE_STYLE_H
+#define HOUSE_STYLE_H
+
+/**
+ * @brief An enum class declaration for the structure of generated houses.
+ * 
+ * Use this enum when choosing how walls are laid out by the house generator.
+ */
+enum class HouseStyle { Open, Maze, Rooms };
+
+#endif
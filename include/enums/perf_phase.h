@@ -0,0 +1,12 @@
+#ifndef PERF_PHASE_H
+#define PERF_PHASE_H
+
+/**
+ * @brief An enum class declaration for the profiled phases of a mission.
+ * 
+ * Use this enum when attributing hardware counters to a part of the program. The planner phases are nested
+ * within Run.
+ */
+enum class PerfPhase { ReadHouseFile, SetAlgorithm, Run, WriteOutput, ClosestAdjacentNode, ClosestNonAdjacentNodePath, PathToDock, Count };
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <string>
+#include <vector>
+#include "simulation.h"
+#include "thread_pool.h"
+
+#define SUMMARY_FILE "summary.csv"
+
+/**
+ * @brief A class declaration for simulating many houses in parallel.
+ *
+ * The "BatchRunner" class runs one independent simulation per house file on a work-stealing thread pool,
+ * writes each mission's results to its own output file, and aggregates every mission into one CSV summary.
+ */
+class BatchRunner {
+public:
+    /**
+     * @brief Constructs a "BatchRunner" object.
+     * @param outputDir The directory to write per-house output files and the summary to.
+     */
+    BatchRunner(std::string outputDir) : outputDir(outputDir), headless(false) {}
+
+    /**
+     * @brief Destroys a "BatchRunner" object.
+     */
+    ~BatchRunner() {}
+
+    /**
+     * @brief Adds a house file, or every regular file within a directory (sorted by name), to the batch.
+     * @param path The house file or directory.
+     * @return true on success, false if the path does not exist.
+     */
+    bool addInput(const std::string path);
+
+    /**
+     * @brief Sets whether houses are simulated without recording steps, so that only the summary is written.
+     * @param headless true to write only the summary, false to also write every house's output file.
+     */
+    void setHeadless(const bool headless);
+
+    /**
+     * @brief Simulates every house in the batch, using one worker thread per hardware thread.
+     * @return true if every house was simulated and all output was written, otherwise false.
+     */
+    bool run();
+
+private:
+    /**
+     * @brief A struct declaration for the outcome of simulating one house.
+     */
+    struct BatchResult {
+        bool success;           // Whether the house was read, simulated and written successfully.
+        MissionSummary summary; // The mission summary, valid on success.
+    };
+
+    std::string outputDir;                  // The directory to write output to.
+    bool headless;                          // Whether per-house output files are skipped.
+    std::vector<std::string> houseFiles;    // The house files in the batch, in submission order.
+    std::vector<std::string> outputFiles;   // The output file of each house file.
+
+    /**
+     * @brief Assigns every house file in the batch its own output file path. A house file gets
+     * "<outputDir>/<name>_output.txt", where the name is the house file's name without extension, suffixed with
+     * "_2", "_3"... if an earlier house file already took it, so that no two missions write the same files.
+     */
+    void assignOutputFiles();
+
+    /**
+     * @brief Simulates a single house and writes its output file.
+     * @param houseFilePath The house file.
+     * @param outputFilePath The output file.
+     * @return The outcome of the simulation.
+     */
+    BatchResult simulate(const std::string houseFilePath, const std::string outputFilePath) const;
+
+    /**
+     * @brief Writes one "House,NumSteps,DirtLeft,Status" row per house to the summary file.
+     * @param results The outcome of each house, in the order of houseFiles.
+     * @return true on success, false if I/O error.
+     */
+    bool writeSummary(const std::vector<BatchResult>& results) const;
+};
+
+#endif
@@ -1,25 +1,28 @@
 #ifndef HOUSE_H
 #define HOUSE_H
 
-#include <string>
-#include <unordered_set>
-#include <unordered_map>
+#include <memory>
+#include <vector>
 #include "coordinate.h"
-#include "file_reader.h"
-#include "hash.h"
+#include "direction.h"
+#include "house_layout.h"
 
 /**
  * @brief A class declaration to represent the internal structure of a house.
  * 
  * The "House" class provides an API to the simulator for retrieving house information and state, 
  * and performs the relevant housekeeping whenever any state changes occur.
+ *
+ * The structure of the house and its initial dirt are immutable and shared by every copy of a "House", so copying
+ * a set-up house is cheap and safe across threads. Cleaning is copy-on-write: the first time a tile is cleaned,
+ * the copy cleaning it takes a private copy of that tile only.
  */
 class House {
 public:
     /**
      * @brief Constructs a "House" object.
      */
-    House() {}
+    House() : remainingDirt(0) {}
 
     /**
      * @brief Destroys a "House" object.
@@ -27,11 +30,10 @@ public:
     ~House() {}
 
     /**
-     * @brief Reads from input file to store information about the internal structure of the house.
-     * @param infile_name The name of the input file.
-     * @return true if success, false if I/O error.
+     * @brief Stores information about the internal structure of the house from the parsed house file.
+     * @param layout The parsed house file.
      */
-    bool houseSetup(const std::string infilePath);
+    void houseSetup(const HouseLayout& layout);
 
      /**
      * @brief Checks if the specified space is valid within the house (i.e. not a wall).
@@ -40,6 +42,13 @@ public:
      */
     bool isValidSpace(const Coordinate space) const;
 
+    /**
+     * @brief Checks for the walls surrounding the specified space.
+     * @param space The specified space.
+     * @return A bitmask with bit "static_cast<int>(Direction)" set for every direction blocked by a wall.
+     */
+    unsigned char getWalls(const Coordinate space) const;
+
     /**
      * @brief Checks for the amount of dirt at the specified space.
      * @param space The specified space.
@@ -48,11 +57,18 @@ public:
     int getDirt(const Coordinate space) const;
 
     /**
-     * @brief Checks for the amount of remaining dirt throughout the entire house.
+     * @brief Checks for the amount of remaining dirt throughout the entire house, maintained as a running total.
      * @return The amount of remaining dirt.
      */
     int getRemainingDirt() const;
 
+    /**
+     * @brief Checks for the amount of remaining dirt within the tile (TILE_SIZE x TILE_SIZE region) containing the specified space.
+     * @param space The specified space.
+     * @return The amount of remaining dirt, or 0 if the space lies outside the house.
+     */
+    int getTileDirt(const Coordinate space) const;
+
     /**
      * @brief Checks if the house is entirely clean (i.e. no dirt).
      * @return true if house is clean, otherwise false.
@@ -65,9 +81,57 @@ public:
      */
     void cleanSpace(const Coordinate space);
 
+    /**
+     * @brief Cleans the specified space within the house repeatedly, as if cleaned that many times in a row.
+     * @param space The specified space.
+     * @param times The number of times to clean it. Cleaning stops once the space has no dirt left.
+     */
+    void cleanSpace(const Coordinate space, const int times);
+
 private:
-    std::unordered_set<Coordinate, cHash> spaces;          /* A unordered set of valid spaces that the robot can reach. Spaces are relative to the charging dock (origin). */
-    std::unordered_map<Coordinate, int, cHash> dirtLevel;  /* An unordered map of valid space : dirt level. */
+    static constexpr unsigned char DIRT_MASK = 0x0F;   // Low nibble of a cell: dirt level.
+    static constexpr unsigned char WALL_SHIFT = 4;     // High nibble of a cell: mask of surrounding walls.
+    static constexpr unsigned char WALL_CELL = 0xFF;   // Cell value used to mark a wall.
+    static constexpr unsigned char ALL_WALLS = 0x0F;   // Wall mask of a space enclosed on all sides.
+    static constexpr int TILE_SIZE = 64;               // Side length of the square regions dirt is summarized and copied over.
+
+    /**
+     * @brief A struct declaration for the immutable part of the house, shared by every copy.
+     */
+    struct Grid {
+        int rows;                                      // The number of rows in the house.
+        int cols;                                      // The number of columns in the house.
+        int dockRow;                                   // The row of the charging dock (origin).
+        int dockCol;                                   // The column of the charging dock (origin).
+        int tileCols;                                  // The number of tiles per row of tiles.
+        std::vector<unsigned char> cells;              // Row-major cells, each packing initial dirt level and surrounding walls.
+        std::vector<int> tileDirt;                     // Row-major initial dirt of each tile.
+        int remainingDirt;                             // Initial dirt throughout the entire house.
+    };
+
+    std::shared_ptr<const Grid> grid;                  // Structure and initial dirt of the house.
+    std::vector<std::vector<unsigned char>> tileCells; // Private TILE_SIZE x TILE_SIZE copy of each cleaned tile, empty until first cleaned.
+    std::vector<int> tileDirt;                         // Row-major remaining dirt of each tile.
+    int remainingDirt;                                 // Remaining dirt throughout the entire house.
+
+    /**
+     * @brief Converts the specified space into a row and column of the house.
+     * @param space The specified space, relative to the charging dock (origin).
+     * @param row The row of the space, on success.
+     * @param col The column of the space, on success.
+     * @return true if the space lies within the house and is not a wall, otherwise false.
+     */
+    bool locate(const Coordinate space, int& row, int& col) const;
+
+    /**
+     * @brief Gets the index of the tile containing the specified cell.
+     */
+    inline long tileIndex(int row, int col) const { return long(row / TILE_SIZE) * this->grid->tileCols + col / TILE_SIZE; }
+
+    /**
+     * @brief Gets the index of the specified cell within its tile.
+     */
+    inline long tileOffset(int row, int col) const { return (row % TILE_SIZE) * TILE_SIZE + col % TILE_SIZE; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,99 @@
+#ifndef LOCKSTEP_SIMULATION_H
+#define LOCKSTEP_SIMULATION_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "robot_lanes.h"
+#include "simulation.h"
+
+/**
+ * @brief A class declaration for simulating many robots' missions in lockstep.
+ *
+ * The "LockstepSimulation" class advances every mission by one step per round: each still running algorithm is
+ * queried for its next step, then all robots are moved together through "RobotLanes". Each mission has its own
+ * house copy, algorithm, sensors and output file, and produces exactly the output a "Simulation" would.
+ */
+class LockstepSimulation {
+public:
+    /**
+     * @brief Constructs an empty "LockstepSimulation" object.
+     * @param headless true to skip recording steps and writing output files, keeping only each mission's summary.
+     */
+    LockstepSimulation(bool headless = false) : headless(headless) {}
+
+    /**
+     * @brief Destroys a "LockstepSimulation" object.
+     */
+    ~LockstepSimulation() {}
+
+    /**
+     * @brief Adds a mission on a copy of an already set-up house.
+     * @param house The set-up house, whose structure is shared rather than copied.
+     * @param maxSteps The number of steps allocated to the robot for the mission.
+     * @param maxBattery The battery capacity of the robot.
+     * @param outputFilePath The location of the mission's output file.
+     * @return The index of the mission.
+     */
+    std::size_t addMission(const House& house, const int maxSteps, const int maxBattery, const std::string outputFilePath);
+
+    /**
+     * @brief Checks for the number of missions.
+     * @return The number of missions.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Simulates every mission to completion, then logs the results of each mission to its output file unless
+     * headless.
+     * @return true if every output file was written, otherwise false.
+     */
+    bool run();
+
+    /**
+     * @brief Checks if the output file of the specified mission was written.
+     * @param mission The index of the mission.
+     * @return true if written, or run headless, false if I/O error or not yet run.
+     */
+    bool outputWritten(const std::size_t mission) const;
+
+    /**
+     * @brief Summarizes the results of the specified mission.
+     * @param mission The index of the mission.
+     * @return The mission summary.
+     */
+    MissionSummary getSummary(const std::size_t mission) const;
+
+private:
+    /**
+     * @brief A struct declaration for the per-mission state not held in lanes.
+     */
+    struct Mission {
+        House h;
+        ConcreteAlgorithm algo;
+
+        ConcreteBatteryMeter bm;
+        ConcreteDirtSensor ds;
+        ConcreteWallsSensor ws;
+
+        FileWriter fw;
+        bool finished;  // Whether the algorithm reported that the mission finished.
+        bool written;   // Whether the output file was written.
+
+        Mission(std::string outputFilePath) : fw(outputFilePath), finished(false), written(false) {}
+    };
+
+    bool headless;                                  // Whether steps are recorded and output files written.
+    RobotLanes robots;                              // One lane per mission, in mission order.
+    std::vector<std::unique_ptr<Mission>> missions; // Heap allocated, as algorithms keep pointers to the sensors.
+
+    /**
+     * @brief Updates the sensors of the specified mission and queries its algorithm for the next step.
+     * @param mission The index of the mission.
+     * @return The next step.
+     */
+    Step queryAlgorithm(const std::size_t mission);
+};
+
+#endif
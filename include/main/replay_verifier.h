@@ -0,0 +1,135 @@
+#ifndef REPLAY_VERIFIER_H
+#define REPLAY_VERIFIER_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include "coordinate.h"
+#include "house.h"
+#include "step.h"
+
+/**
+ * @brief A struct declaration for the outcome of replaying a recorded mission.
+ */
+struct ReplayReport {
+    bool valid;                     // Whether the mission replayed without violations and matches what it reported.
+    std::string error;              // The first violation or mismatch found, empty if valid.
+    std::uint64_t errorStep;        // The step (counted from 1) the violation happened at, or 0 if not tied to a step.
+
+    std::uint64_t numSteps;         // The number of steps replayed.
+    int dirtLeft;                   // The amount of remaining uncleaned dirt in the house after replay.
+    std::string status;             // The final status of the robot after replay (FINISHED/WORKING/DEAD).
+    bool onDock;                    // Whether the robot ended on the charging dock.
+
+    std::uint64_t moveSteps;        // Steps spent moving.
+    std::uint64_t cleaningSteps;    // Steps spent staying off the dock.
+    std::uint64_t chargingSteps;    // Steps spent staying on the dock.
+    int dirtCleaned;                // The amount of dirt cleaned.
+    std::uint64_t score;            // The assignment's score of the mission, see "ReplayVerifier::score"; lower is better.
+};
+
+/**
+ * @brief A class declaration for verifying a recorded mission by replaying it without any algorithm.
+ *
+ * The "ReplayVerifier" class re-simulates a mission from its output file or binary step trace, with the semantics
+ * of "Robot::move" and "House::cleanSpace", and checks that the robot never enters a wall, never runs its battery
+ * below 0, never exceeds the mission budget, only finishes on the charging dock and never steps after, and that the
+ * reported NumSteps, DirtLeft and Status match the replay. Runs of identical steps are replayed in bulk: a run of
+ * stays costs constant time however long, and a run of moves a single wall check per space crossed.
+ */
+class ReplayVerifier {
+public:
+    /**
+     * @brief Constructs a "ReplayVerifier" object.
+     */
+    ReplayVerifier() : maxSteps(0), maxBattery(0) {}
+
+    /**
+     * @brief Destroys a "ReplayVerifier" object.
+     */
+    ~ReplayVerifier() {}
+
+    /**
+     * @brief Reads and parses the house file the mission ran on.
+     * @param houseFilePath The house file.
+     * @return true on success, false if I/O error or invalid input.
+     */
+    bool readHouseFile(const std::string houseFilePath);
+
+    /**
+     * @brief Replays a recorded mission, either an output file or a binary step trace, told apart by its contents.
+     * @param stepsFilePath The output file or step trace.
+     * @return true if the mission is valid, otherwise false with the reason in the report.
+     */
+    bool verify(const std::string stepsFilePath);
+
+    /**
+     * @brief Gets the outcome of the last verification.
+     * @return The report.
+     */
+    const ReplayReport& getReport() const;
+
+private:
+    House house;                // The house as parsed, copied for each replay.
+    int maxSteps;               // The number of steps allocated to the robot for the mission.
+    int maxBattery;             // The battery capacity of the robot.
+
+    /* Replay state. */
+    House h;                    // The house being cleaned.
+    Coordinate loc;             // The location of the robot.
+    long batteryLeft;           // The remaining amount of battery left in the robot.
+    bool finished;              // Whether a Finish step was replayed.
+    ReplayReport report;        // The report being built.
+
+    /**
+     * @brief Resets the replay state to the start of the mission.
+     */
+    void reset();
+
+    /**
+     * @brief Replays the steps of an output file, and reads the results it reports.
+     * @param in The output file, positioned at its start.
+     * @param numSteps The reported NumSteps.
+     * @param dirtLeft The reported DirtLeft.
+     * @param status The reported Status.
+     * @return true if the file is well formed and every step is valid, otherwise false.
+     */
+    bool replayOutput(std::istream& in, std::uint64_t& numSteps, int& dirtLeft, std::string& status);
+
+    /**
+     * @brief Replays the steps of a binary step trace, and reads the results it reports.
+     * @param stepsFilePath The step trace.
+     * @param numSteps The reported NumSteps.
+     * @param dirtLeft The reported DirtLeft.
+     * @param status The reported Status.
+     * @return true if the trace is well formed and every step is valid, otherwise false.
+     */
+    bool replayTrace(const std::string stepsFilePath, std::uint64_t& numSteps, int& dirtLeft, std::string& status);
+
+    /**
+     * @brief Replays a run of identical steps.
+     * @param s The step.
+     * @param length The number of steps in the run.
+     * @return true if every step is valid, otherwise false with the reason in the report.
+     */
+    bool replay(const Step s, const std::uint64_t length);
+
+    /**
+     * @brief Scores the replayed mission by the assignment's scoring rule, lower being better:
+     *   - MaxSteps + 300 * DirtLeft + 2000 if the robot is DEAD;
+     *   - MaxSteps + 300 * DirtLeft + 3000 if the robot is FINISHED away from the charging dock;
+     *   - NumSteps + 300 * DirtLeft, plus 1000 if the robot is not on the charging dock, otherwise.
+     * @return The score.
+     */
+    std::uint64_t score() const;
+
+    /**
+     * @brief Records a violation.
+     * @param error The violation.
+     * @param step The step it happened at, or 0.
+     * @return false.
+     */
+    bool fail(const std::string error, const std::uint64_t step);
+};
+
+#endif
@@ -4,7 +4,7 @@
 #include <string>
 #include "step.h"
 #include "coordinate.h"
-#include "file_reader.h"
+#include "house_layout.h"
 
 /**
  * @brief A class declaration to represent the state of the cleaning robot.
@@ -25,17 +25,29 @@ public:
     ~Robot() {}
 
     /**
-     * @brief Reads from input file to store information about the robot.
-     * @param infile_name The name of the input file.
-     * @return true if success, false if I/O error.
+     * @brief Stores information about the robot from the parsed house file.
+     * @param layout The parsed house file.
      */
-    bool robotSetup(const std::string infilePath);
+    void robotSetup(const HouseLayout& layout);
+
+    /**
+     * @brief Stores information about the robot from explicit mission parameters.
+     * @param maxSteps The number of steps allocated to the robot for the mission.
+     * @param maxBattery The battery capacity of the robot.
+     */
+    void robotSetup(const int maxSteps, const int maxBattery);
 
     /**
      * @brief Checks for the number of steps allocated to the robot for the mission.
      * @return The number of allocated steps.
     */
     int getMissionBudget() const;
+
+    /**
+     * @brief Checks for the battery capacity of the robot.
+     * @return The battery capacity.
+     */
+    int getBatteryCap() const;
     
     /** 
      * @brief Checks for the total number of steps the robot has taken.
@@ -73,6 +85,13 @@ public:
      */
     void move(const Step s);
 
+    /**
+     * @brief Stays in place the specified number of times in a row, with the same effect as as many calls to move()
+     * with Step::Stay, computed at once.
+     * @param times The number of times to stay.
+     */
+    void stay(const int times);
+
 private:
     int batteryCap;      // The battery capacity of the robot.
     int missionBudget;   // The number of steps allocated to the robot for the mission.
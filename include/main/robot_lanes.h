@@ -0,0 +1,112 @@
+#ifndef ROBOT_LANES_H
+#define ROBOT_LANES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "step.h"
+#include "coordinate.h"
+
+/**
+ * @brief A class declaration to represent the state of many cleaning robots at once.
+ *
+ * The "RobotLanes" class is the struct-of-arrays counterpart of "Robot": each robot is one lane, and every
+ * attribute lives in its own array. Steps are staged per lane, then applied to every staged lane in one pass
+ * that updates LANE_WIDTH lanes per SSE2 instruction where available, following exactly the rules of Robot::move.
+ */
+class RobotLanes {
+public:
+    static constexpr std::size_t LANE_WIDTH = 4;    // Lanes updated together, one 32-bit lane per robot.
+
+    /**
+     * @brief Constructs an empty "RobotLanes" object.
+     */
+    RobotLanes() : count(0) {}
+
+    /**
+     * @brief Destroys a "RobotLanes" object.
+     */
+    ~RobotLanes() {}
+
+    /**
+     * @brief Adds a robot, placed on the charging dock with a full battery.
+     * @param maxSteps The number of steps allocated to the robot for the mission.
+     * @param maxBattery The battery capacity of the robot.
+     * @return The lane of the robot.
+     */
+    std::size_t addRobot(const int maxSteps, const int maxBattery);
+
+    /**
+     * @brief Checks for the number of robots.
+     * @return The number of robots.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks for the number of steps allocated to the specified robot for the mission.
+     * @param lane The lane of the robot.
+     * @return The number of allocated steps.
+     */
+    int getMissionBudget(const std::size_t lane) const;
+
+    /**
+     * @brief Checks for the total number of steps the specified robot has taken.
+     * @param lane The lane of the robot.
+     * @return The number of steps.
+     */
+    int getStepCount(const std::size_t lane) const;
+
+    /**
+     * @brief Checks for the amount of remaining battery the specified robot has left.
+     * @param lane The lane of the robot.
+     * @return The amount of battery.
+     */
+    int getBatteryLeft(const std::size_t lane) const;
+
+    /**
+     * @brief Checks for the current location of the specified robot.
+     * @param lane The lane of the robot.
+     * @return The location of the robot.
+     */
+    Coordinate getLoc(const std::size_t lane) const;
+
+    /**
+     * @brief Checks if the specified robot has taken enough steps to meet or exceed the budget.
+     * @param lane The lane of the robot.
+     * @return true if the budget is met or exceeded, otherwise false.
+     */
+    bool budgetExceeded(const std::size_t lane) const;
+
+    /**
+     * @brief Stages the next step of the specified robot, to be applied by the next call to move().
+     * @param lane The lane of the robot.
+     * @param s The next step the robot should take.
+     */
+    void stageStep(const std::size_t lane, const Step s);
+
+    /**
+     * @brief Moves every robot with a staged step in the staged manner, then clears all staged steps.
+     * Robots without a staged step are left untouched.
+     */
+    void move();
+
+private:
+    std::size_t count;                   // The number of robots; arrays are padded to a multiple of LANE_WIDTH.
+
+    std::vector<std::int32_t> batteryCap;     // The battery capacity of each robot.
+    std::vector<std::int32_t> chargeRate;     // The battery gained per step on the charging dock, batteryCap / 20.
+    std::vector<std::int32_t> missionBudget;  // The number of steps allocated to each robot for the mission.
+
+    std::vector<std::int32_t> stepCount;      // The total number of steps made by each robot.
+    std::vector<std::int32_t> batteryLeft;    // The remaining amount of battery left in each robot.
+    std::vector<std::int32_t> x;              // The x of each robot's location.
+    std::vector<std::int32_t> y;              // The y of each robot's location.
+
+    std::vector<std::int32_t> staged;         // All ones if the robot has a staged step, otherwise 0.
+    std::vector<std::int32_t> dx;             // Change in x of the staged step.
+    std::vector<std::int32_t> dy;             // Change in y of the staged step.
+    std::vector<std::int32_t> stay;           // All ones if the staged step is Stay, otherwise 0.
+    std::vector<std::int32_t> finish;         // All ones if the staged step is Finish, otherwise 0.
+};
+
+#endif
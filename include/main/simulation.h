@@ -1,27 +1,57 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <string>
+#include <type_traits>
 #include "concrete_algorithm.h"
 #include "concrete_battery_meter.h"
 #include "concrete_dirt_sensor.h"
 #include "concrete_walls_sensor.h"
+#include "specialized_algorithm.h"
 #include "house.h"
 #include "robot.h"
+#include "file_reader.h"
 #include "file_writer.h"
+#include "instrumentation.h"
+#include "perf_profiler.h"
+#include "step_trace.h"
+#include "trace_writer.h"
 
 /**
- * @brief A class declaration for simulating the robot's mission.
+ * @brief A struct declaration for the summary of a finished mission, as written to the output file.
+ */
+struct MissionSummary {
+    int numSteps;        // The number of steps the robot took throughout the mission.
+    int dirtLeft;        // The amount of remaining uncleaned dirt in the house.
+    std::string status;  // The final status of the robot (FINISHED/WORKING/DEAD).
+};
+
+/**
+ * @brief A class template declaration for simulating the robot's mission.
  * 
- * The "Simulation" class provides an abstraction of all the algorithmic and state-maintaining functionality
- * of the program, such that main() can easily setup the control flow.
+ * The "Simulation" class template provides an abstraction of all the algorithmic and state-maintaining functionality
+ * of the program, such that main() can easily setup the control flow. The algorithm and sensor types are known at
+ * compile time, so the algorithm is called without virtual dispatch. By default the algorithm is specialized for the
+ * sensors too, so that it reads them directly; any "AbstractAlgorithm", such as "ConcreteAlgorithm", may instead read
+ * them through their abstract interfaces. Members are defined below, so any such algorithm can be simulated.
+ *
+ * @tparam Algo The type of the algorithm, an "AbstractAlgorithm".
+ * @tparam BM The type of the battery meter.
+ * @tparam DS The type of the dirt sensor.
+ * @tparam WS The type of the walls sensor.
  */
+template <typename Algo = ConcreteSpecializedAlgorithm, typename BM = ConcreteBatteryMeter, typename DS = ConcreteDirtSensor,
+          typename WS = ConcreteWallsSensor>
 class Simulation {
 public:
     /**
      * @brief Constructs a "Simulation" object.
+     * @param outputFilePath The location of the output file.
      */
-    Simulation() {}
+    Simulation(std::string outputFilePath = OFILE) : fw(outputFilePath), profiler(nullptr), tracer(nullptr), stepTrace(nullptr), headless(false), finished(false), chargeFirstStep(-1), chargeLastStep(-1) {}
 
     /**
      * @brief Destroys a "Simulation" object.
@@ -35,11 +65,49 @@ public:
      */
     bool readHouseFile(const std::string houseFilePath);
 
+    /**
+     * @brief Initializes the house and robot objects from an already set-up house, to prepare for simulation start.
+     * The house structure is shared with the given house rather than copied, and cleaning does not affect it.
+     * @param house The set-up house.
+     * @param maxSteps The number of steps allocated to the robot for the mission.
+     * @param maxBattery The battery capacity of the robot.
+     */
+    void setHouse(const House& house, const int maxSteps, const int maxBattery);
+
+    /**
+     * @brief Stores the profiler to attribute hardware counters of each phase to. Must be set before the phases
+     * run, and before setAlgorithm() for the planner's searches to be profiled.
+     * @param profiler The profiler, or nullptr to not profile.
+     */
+    void setProfiler(PerfProfiler* profiler);
+
+    /**
+     * @brief Stores the trace writer to record a timeline of the mission to: parsing, every replan, every stretch of
+     * charging and the writing of the output. Must be set before the phases run, and before setAlgorithm() for the
+     * planner's replans to be traced.
+     * @param tracer The trace writer, or nullptr to not trace.
+     */
+    void setTracer(TraceWriter* tracer);
+
+    /**
+     * @brief Stores the writer to also record the robot's steps to as a compact binary trace, alongside the output
+     * file. The trace is created when the mission starts and completed when the output is written.
+     * @param stepTrace The step trace writer, or nullptr to not write one.
+     */
+    void setStepTrace(StepTraceWriter* stepTrace);
+
+    /**
+     * @brief Sets whether to skip recording steps, keeping only the mission summary. A headless mission writes no
+     * output file, and its results are only available through getSummary().
+     * @param headless true to skip recording steps, false to record them and write the output file.
+     */
+    void setHeadless(const bool headless);
+
     /**
      * @brief Initializes the algorithm to prepare for simulation start.
      * @param algorithm The algorithm object.
      */
-    void setAlgorithm(ConcreteAlgorithm algorithm);
+    void setAlgorithm(Algo algorithm);
 
     /**
      * @brief Begin simulation of the robot's mission.
@@ -48,21 +116,265 @@ public:
     bool run();
 
     /**
-     * @brief Log the results of the mission to file. 
+     * @brief Log the results of the mission to file, unless headless.
      * @return true if success, false if I/O error.
      */
     bool writeOutput();
 
+    /**
+     * @brief Summarizes the results of the mission.
+     * @return The mission summary.
+     */
+    MissionSummary getSummary() const;
+
+#ifdef ROBOT_INSTRUMENT
+    /**
+     * @brief Writes the counters of the simulator and algorithm, and the nextSteps() latency histogram, as JSON.
+     * @param statsFilePath The location of the file to write.
+     * @return true if success, false if I/O error.
+     */
+    bool writeStats(const std::string statsFilePath) const;
+#endif
+
 private:
+    static constexpr std::size_t PLAN_SIZE = 256;   // Most steps the algorithm is asked to plan at a time.
+
     House h;
     Robot r;
-    ConcreteAlgorithm algo;
+    Algo algo;
 
-    ConcreteBatteryMeter bm;
-    ConcreteDirtSensor ds;
-    ConcreteWallsSensor ws;
+    BM bm;
+    DS ds;
+    WS ws;
 
     FileWriter fw;
+    PerfProfiler* profiler;
+    TraceWriter* tracer;
+    StepTraceWriter* stepTrace;
+    bool headless;      // Whether steps are recorded and the output file written.
+    bool finished;      // Whether the algorithm reported that the mission finished.
+
+    std::chrono::steady_clock::time_point stepEnd;      // When the previous step was taken, while tracing.
+    std::chrono::steady_clock::time_point chargeStart;  // When the current stretch of charging started, while tracing.
+    std::chrono::steady_clock::time_point chargeEnd;    // When the last step of the current stretch of charging ended.
+    int chargeFirstStep;                                // First step of the current stretch of charging, or -1 if not charging.
+    int chargeLastStep;                                 // Last step of the current stretch of charging.
+
+#ifdef ROBOT_INSTRUMENT
+    SimulationStats stats;
+#endif
+
+    /**
+     * @brief Traces consecutive steps spent charging on the dock as a single span, once the stretch ends.
+     * @param charging Whether the step just taken was spent charging.
+     */
+    void traceCharging(const bool charging);
 };
 
+template <typename Algo, typename BM, typename DS, typename WS>
+bool Simulation<Algo, BM, DS, WS>::readHouseFile(const std::string houseFilePath) {
+    PerfScope scope(this->profiler, PerfPhase::ReadHouseFile);
+    TraceScope span(this->tracer, "readHouseFile", "io", -1);
+    FileReader fr = FileReader(houseFilePath);
+    HouseLayout layout;
+
+    /* I/O error or invalid input. */
+    if(!fr.readHouse(layout))
+        return false;
+
+    this->h.houseSetup(layout);
+    this->r.robotSetup(layout);
+    return true;
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::setHouse(const House& house, const int maxSteps, const int maxBattery) {
+    this->h = house;
+    this->r.robotSetup(maxSteps, maxBattery);
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::setProfiler(PerfProfiler* profiler) {
+    this->profiler = profiler;
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::setTracer(TraceWriter* tracer) {
+    this->tracer = tracer;
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::setStepTrace(StepTraceWriter* stepTrace) {
+    this->stepTrace = stepTrace;
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::setHeadless(const bool headless) {
+    this->headless = headless;
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::setAlgorithm(Algo algorithm) {
+    PerfScope scope(this->profiler, PerfPhase::SetAlgorithm);
+    if constexpr(std::is_base_of_v<ConcreteAlgorithm, Algo>) {
+        algorithm.setProfiler(this->profiler);
+        algorithm.setTracer(this->tracer);
+    }
+    algorithm.setMaxSteps(this->r.getMissionBudget());
+    algorithm.setBatteryMeter(this->bm);
+    algorithm.setDirtSensor(this->ds);
+    algorithm.setWallsSensor(this->ws);
+    this->algo = algorithm;
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+bool Simulation<Algo, BM, DS, WS>::run() {
+    if(this->stepTrace && !this->stepTrace->open(this->r.getMissionBudget(), this->r.getBatteryCap()))
+        return false;
+
+    {
+        PerfScope scope(this->profiler, PerfPhase::Run);
+        TraceScope span(this->tracer, "run", "mission", 0);
+        if(this->tracer)
+            this->stepEnd = std::chrono::steady_clock::now();
+
+        /* Iterate until maxSteps is reached. */
+        Step plan[PLAN_SIZE];
+        while(!this->finished && !this->r.budgetExceeded()) {
+            Coordinate currLoc = this->r.getLoc();
+            unsigned char walls = this->h.getWalls(currLoc);
+            bool northWall = walls & (1 << static_cast<int>(Direction::North));
+            bool westWall = walls & (1 << static_cast<int>(Direction::West));
+            bool southWall = walls & (1 << static_cast<int>(Direction::South));
+            bool eastWall = walls & (1 << static_cast<int>(Direction::East));
+
+            /* Update sensors, once per plan. */
+            this->bm.setBatteryState(this->r.getBatteryLeft());
+            this->ds.setDirtLevel(this->h.getDirt(currLoc));
+            this->ws.setWall(northWall, Direction::North);
+            this->ws.setWall(westWall, Direction::West);
+            this->ws.setWall(southWall, Direction::South);
+            this->ws.setWall(eastWall, Direction::East);
+
+            /* Get the next algorithm moves, never past the mission budget. */
+            std::size_t stepsLeft = this->r.getMissionBudget() - this->r.getStepCount();
+            INSTRUMENT(auto start = std::chrono::steady_clock::now();)
+            std::size_t planned = this->algo.nextSteps(plan, std::min(stepsLeft, PLAN_SIZE));
+            INSTRUMENT(this->stats.nextStepLatency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());)
+
+            for(std::size_t i = 0; i < planned; i++) {
+                Step nextStep = plan[i];
+                if(!this->headless)
+                    this->fw.recordStep(nextStep);
+                if(this->stepTrace)
+                    this->stepTrace->recordStep(nextStep);
+                this->r.move(nextStep);
+
+                /* Exit early if finished. */
+                if(nextStep == Step::Finish) {
+                    this->finished = true;
+                    break;
+                }
+
+                /* Clean spot if stayed. */
+                if(nextStep == Step::Stay)
+                    this->h.cleanSpace(this->r.getLoc());
+                INSTRUMENT(
+                    if(nextStep != Step::Stay)
+                        this->stats.moveSteps++;
+                    else if(this->r.onChargingDock())
+                        this->stats.chargingSteps++;
+                    else
+                        this->stats.cleaningSteps++;
+                )
+                if(this->tracer)
+                    traceCharging(nextStep == Step::Stay && this->r.onChargingDock());
+            }
+
+            /* A plan ending in a stay may go on staying, take those stays all at once. */
+            if(this->finished || planned == 0 || plan[planned - 1] != Step::Stay)
+                continue;
+            std::size_t stays = this->algo.repeatStay(this->r.getMissionBudget() - this->r.getStepCount());
+            if(stays == 0)
+                continue;
+            if(!this->headless)
+                this->fw.recordSteps(Step::Stay, stays);
+            if(this->stepTrace)
+                this->stepTrace->recordSteps(Step::Stay, stays);
+            this->r.stay(static_cast<int>(stays));
+            this->h.cleanSpace(this->r.getLoc(), static_cast<int>(stays));
+            INSTRUMENT(
+                if(this->r.onChargingDock())
+                    this->stats.chargingSteps += stays;
+                else
+                    this->stats.cleaningSteps += stays;
+            )
+            if(this->tracer)
+                traceCharging(this->r.onChargingDock());
+        }
+
+        /* Close a stretch of charging the mission ended in. */
+        if(this->tracer)
+            traceCharging(false);
+    }
+    return writeOutput();
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+bool Simulation<Algo, BM, DS, WS>::writeOutput() {
+    PerfScope scope(this->profiler, PerfPhase::WriteOutput);
+    TraceScope span(this->tracer, "writeOutput", "io", this->r.getStepCount());
+    int totalSteps = this->r.getStepCount();
+    int dirtLeft = this->h.getRemainingDirt();
+    int batteryLeft = this->r.getBatteryLeft();
+    if(this->stepTrace && !this->stepTrace->close(dirtLeft, FileWriter::getRobotStatus(this->finished, batteryLeft)))
+        return false;
+    if(this->headless)
+        return true;
+    return this->fw.recordResults(totalSteps, dirtLeft, batteryLeft);
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+void Simulation<Algo, BM, DS, WS>::traceCharging(const bool charging) {
+    /* A step starts when the step before it ended. */
+    std::chrono::steady_clock::time_point stepStart = this->stepEnd;
+    this->stepEnd = std::chrono::steady_clock::now();
+
+    if(charging) {
+        if(this->chargeFirstStep < 0) {
+            this->chargeStart = stepStart;
+            this->chargeFirstStep = this->r.getStepCount();
+        }
+        this->chargeEnd = this->stepEnd;
+        this->chargeLastStep = this->r.getStepCount();
+    }
+    else if(this->chargeFirstStep >= 0) {
+        int steps = this->chargeLastStep - this->chargeFirstStep + 1;
+        this->tracer->complete("charging", "robot", this->chargeStart, this->chargeEnd, this->chargeFirstStep, steps);
+        this->chargeFirstStep = -1;
+    }
+}
+
+template <typename Algo, typename BM, typename DS, typename WS>
+MissionSummary Simulation<Algo, BM, DS, WS>::getSummary() const {
+    return MissionSummary{this->r.getStepCount(), this->h.getRemainingDirt(), FileWriter::getRobotStatus(this->finished, this->r.getBatteryLeft())};
+}
+
+#ifdef ROBOT_INSTRUMENT
+template <typename Algo, typename BM, typename DS, typename WS>
+bool Simulation<Algo, BM, DS, WS>::writeStats(const std::string statsFilePath) const {
+    std::ofstream f = std::ofstream(statsFilePath);
+    if(f.fail())
+        return false;
+
+    this->stats.writeJson(f, this->algo.getStats());
+    return f.good();
+}
+#endif
+
+/**
+ * @brief A simulation of an algorithm that reads the simulator's sensors through their abstract interfaces.
+ */
+using AbstractSimulation = Simulation<ConcreteAlgorithm>;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include <string>
+#include <vector>
+#include "lockstep_simulation.h"
+#include "thread_pool.h"
+
+#define SWEEP_FILE "sweep.csv"
+
+/**
+ * @brief A class declaration for simulating one house under many mission parameters in parallel.
+ *
+ * The "SweepRunner" class parses a house file once, then runs one simulation per (MaxSteps, MaxBattery) pair.
+ * Runs are grouped into lockstep simulations of up to MAX_RUNS_PER_TASK missions, which are spread over a
+ * work-stealing thread pool. Every run shares the parsed house structure and only copies the tiles it cleans, and
+ * the results of every run are aggregated into one CSV grid.
+ */
+class SweepRunner {
+public:
+    /**
+     * @brief Constructs a "SweepRunner" object.
+     * @param outputDir The directory to write per-run output files and the results grid to.
+     */
+    SweepRunner(std::string outputDir) : outputDir(outputDir), headless(false), houseSteps(0), houseBattery(0) {}
+
+    /**
+     * @brief Destroys a "SweepRunner" object.
+     */
+    ~SweepRunner() {}
+
+    /**
+     * @brief Reads and parses the house file shared by every run.
+     * @param houseFilePath The house file.
+     * @return true on success, false if I/O error or invalid input.
+     */
+    bool readHouseFile(const std::string houseFilePath);
+
+    /**
+     * @brief Adds mission budgets to the sweep.
+     * @param spec A comma separated list of values "N" or inclusive ranges "first:last[:stride]".
+     * @return true on success, false if the list is malformed, contains a negative value or a reversed range, or
+     * sweeps more than MAX_VALUES budgets.
+     */
+    bool addSteps(const std::string spec);
+
+    /**
+     * @brief Adds battery capacities to the sweep.
+     * @param spec A comma separated list of values "N" or inclusive ranges "first:last[:stride]".
+     * @return true on success, false if the list is malformed, contains a non-positive value or a reversed range, or
+     * sweeps more than MAX_VALUES capacities.
+     */
+    bool addBattery(const std::string spec);
+
+    /**
+     * @brief Sets whether runs skip recording steps, so that only the results grid is written.
+     * @param headless true to write only the results grid, false to also write every run's output file.
+     */
+    void setHeadless(const bool headless);
+
+    /**
+     * @brief Simulates every (MaxSteps, MaxBattery) pair of the sweep, using one worker thread per hardware thread.
+     * @return true if every run was simulated and all output was written, otherwise false.
+     */
+    bool run();
+
+private:
+    static constexpr std::size_t MAX_RUNS_PER_TASK = 64;   // Most missions simulated in lockstep by one task.
+    static constexpr std::size_t MAX_VALUES = 1000;        // Most distinct values swept along either axis, so at most a million runs.
+
+    /**
+     * @brief A struct declaration for the outcome of a single run.
+     */
+    struct SweepResult {
+        bool success;           // Whether the run was simulated and written successfully.
+        MissionSummary summary; // The mission summary, valid on success.
+    };
+
+    std::string outputDir;      // The directory to write output to.
+    bool headless;              // Whether per-run output files are skipped.
+    House house;                // The parsed house, shared by every run.
+    int houseSteps;             // The MaxSteps of the house file, used if no budgets are added.
+    int houseBattery;           // The MaxBattery of the house file, used if no capacities are added.
+    std::vector<int> steps;     // The mission budgets of the sweep.
+    std::vector<int> battery;   // The battery capacities of the sweep.
+
+    /**
+     * @brief Parses a comma separated list of values and ranges. Values already in the list, or repeated by it, are
+     * only kept the first time, so that no two runs share an output file.
+     * @param spec The list.
+     * @param minValue The smallest value allowed.
+     * @param values The vector to append the parsed values to.
+     * @return true on success, false if the list is malformed, a value is below minValue, a range is reversed, or
+     * the values would number more than MAX_VALUES.
+     */
+    static bool parseList(const std::string spec, const int minValue, std::vector<int>& values);
+
+    /**
+     * @brief Gets the output file path for the specified run.
+     * @return "<outputDir>/sweep_<maxSteps>_<maxBattery>_output.txt".
+     */
+    std::string outputPathFor(const int maxSteps, const int maxBattery) const;
+
+    /**
+     * @brief Simulates a range of runs in lockstep, each on a copy of the shared house, and writes their output files.
+     * @param first The first run, as an index in row-major (steps, battery) order.
+     * @param last One past the last run.
+     * @param results The outcome of each run, written for the range only.
+     */
+    void simulate(const std::size_t first, const std::size_t last, std::vector<SweepResult>& results) const;
+
+    /**
+     * @brief Writes one "MaxSteps,MaxBattery,NumSteps,DirtLeft,Status" row per run to the results grid.
+     * @param results The outcome of each run, in row-major (steps, battery) order.
+     * @return true on success, false if I/O error.
+     */
+    bool writeGrid(const std::vector<SweepResult>& results) const;
+};
+
+#endif
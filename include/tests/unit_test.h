@@ -0,0 +1,63 @@
+#ifndef UNIT_TEST_H
+#define UNIT_TEST_H
+
+#include <deque>
+#include <functional>
+#include <string>
+
+/**
+ * @brief A class declaration for registering and running unit tests.
+ *
+ * The "TestRunner" class follows the model of "BenchmarkRunner": each TEST() registers itself before main() runs,
+ * and main() runs every test whose name matches the filter. A failed CHECK() is reported with its location and
+ * fails the test, which carries on so that every failed check is reported.
+ */
+class TestRunner {
+public:
+    /**
+     * @brief Registers a test to run.
+     * @param name The name of the test.
+     * @param fn The test function.
+     * @return true, so that registration can initialize a static.
+     */
+    static bool registerTest(std::string name, std::function<void()> fn);
+
+    /**
+     * @brief Records a failed check of the running test.
+     * @param file The source file of the check.
+     * @param line The line of the check.
+     * @param expr The expression that did not hold.
+     */
+    static void fail(const char* file, int line, const std::string expr);
+
+    /**
+     * @brief Runs the registered tests, parsing the command line for an optional --test_filter=<regex>.
+     * @param argc The number of arguments.
+     * @param argv The arguments.
+     * @return 0 if every test passed, otherwise 1.
+     */
+    static int main(int argc, char** argv);
+
+private:
+    struct Test {
+        std::string name;                      // The name of the test.
+        std::function<void()> fn;              // The test function.
+    };
+
+    static std::deque<Test>& registry();
+
+    static int failures;                       // Failed checks of the running test.
+};
+
+#define TEST_CONCAT_(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_(a, b)
+
+#define TEST(name) \
+    static void name(); \
+    static bool TEST_CONCAT(test_, __LINE__) = TestRunner::registerTest(#name, name); \
+    static void name()
+
+#define CHECK(expr) \
+    do { if(!(expr)) TestRunner::fail(__FILE__, __LINE__, #expr); } while(0)
+
+#endif
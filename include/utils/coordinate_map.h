@@ -0,0 +1,262 @@
+#ifndef COORDINATE_MAP_H
+#define COORDINATE_MAP_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "coordinate.h"
+#include "hash.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief A class declaration for an open-addressing hash map keyed on coordinates.
+ *
+ * The "CoordinateMap" class stores its entries inline in a single slot array, so inserting never allocates
+ * per entry. Each slot has a control byte holding either EMPTY, DELETED, or the low 7 bits of the key's
+ * hash. Lookups probe the control bytes a group of GROUP_SIZE at a time, comparing the whole group in one
+ * SSE2 instruction where available, and only touch slots whose control byte matches.
+ *
+ * @tparam V The type of the mapped values.
+ */
+template <typename V>
+class CoordinateMap {
+public:
+    /**
+     * @brief Constructs an empty "CoordinateMap" object.
+     */
+    CoordinateMap() : count_(0), tombstones(0) {}
+
+    /**
+     * @brief Destroys a "CoordinateMap" object.
+     */
+    ~CoordinateMap() {}
+
+    /**
+     * @brief Finds the value mapped to the specified key.
+     * @param key The key to look up.
+     * @return A pointer to the value, or nullptr if the key is absent.
+     */
+    inline V* find(const Coordinate& key) {
+        std::size_t i = findIndex(key);
+        return i == NPOS ? nullptr : &this->slots[i].value;
+    }
+
+    /**
+     * @brief Finds the value mapped to the specified key.
+     * @param key The key to look up.
+     * @return A pointer to the value, or nullptr if the key is absent.
+     */
+    inline const V* find(const Coordinate& key) const {
+        std::size_t i = findIndex(key);
+        return i == NPOS ? nullptr : &this->slots[i].value;
+    }
+
+    /**
+     * @brief Counts the entries with the specified key.
+     * @param key The key to look up.
+     * @return 1 if the key is present, otherwise 0.
+     */
+    inline std::size_t count(const Coordinate& key) const { return findIndex(key) == NPOS ? 0 : 1; }
+
+    /**
+     * @brief Maps the specified key to the specified value, if the key is not already present.
+     * @param key The key to insert.
+     * @param value The value to map the key to.
+     * @return true if inserted, false if the key was already present.
+     */
+    inline bool insert(const Coordinate& key, const V& value) {
+        if(findIndex(key) != NPOS)
+            return false;
+        this->slots[insertIndex(key)].value = value;
+        return true;
+    }
+
+    /**
+     * @brief Gets the value mapped to the specified key, default-constructing it if the key is absent.
+     * @param key The key to look up.
+     * @return A reference to the value.
+     */
+    inline V& operator[](const Coordinate& key) {
+        std::size_t i = findIndex(key);
+        if(i == NPOS) {
+            i = insertIndex(key);
+            this->slots[i].value = V();
+        }
+        return this->slots[i].value;
+    }
+
+    /**
+     * @brief Removes the entry with the specified key, if present.
+     * @param key The key to remove.
+     * @return true if removed, false if the key was absent.
+     */
+    inline bool erase(const Coordinate& key) {
+        std::size_t i = findIndex(key);
+        if(i == NPOS)
+            return false;
+
+        this->ctrl[i] = DELETED;
+        this->count_--;
+        this->tombstones++;
+        return true;
+    }
+
+    /**
+     * @brief Calls f(key, value) for every entry, in unspecified order.
+     * @param f The callable to invoke.
+     */
+    template <typename F>
+    inline void forEach(F f) {
+        for(std::size_t i = 0; i < this->ctrl.size(); i++) {
+            if(this->ctrl[i] >= 0)
+                f(static_cast<const Coordinate&>(this->slots[i].key), this->slots[i].value);
+        }
+    }
+
+    /**
+     * @brief Ensures the specified number of entries fit without rehashing.
+     * @param n The number of entries.
+     */
+    inline void reserve(std::size_t n) {
+        if(n * 8 > capacity() * 7)
+            rehash(n);
+    }
+
+    /**
+     * @brief Removes every entry, keeping the allocated capacity.
+     */
+    inline void clear() {
+        std::memset(this->ctrl.data(), EMPTY, this->ctrl.size());
+        this->count_ = 0;
+        this->tombstones = 0;
+    }
+
+    inline std::size_t size() const { return this->count_; }
+    inline bool empty() const { return this->count_ == 0; }
+    inline std::size_t capacity() const { return this->ctrl.size(); }
+
+private:
+    static constexpr std::int8_t EMPTY = -128;          // Control byte of a slot that has never held an entry.
+    static constexpr std::int8_t DELETED = -2;          // Control byte of a slot whose entry was erased.
+    static constexpr std::size_t GROUP_SIZE = 16;       // Number of control bytes probed at once.
+    static constexpr std::size_t NPOS = -1;             // Index that refers to no slot.
+
+    struct Slot {
+        Coordinate key;
+        V value;
+    };
+
+    std::vector<std::int8_t> ctrl;                      // Control byte of each slot.
+    std::vector<Slot> slots;                            // Entries, stored inline.
+    std::size_t count_;                                 // Number of live entries.
+    std::size_t tombstones;                             // Number of DELETED control bytes.
+
+    /**
+     * @brief Gets a bitmask with bit i set for every control byte in the group equal to the specified byte.
+     */
+    inline unsigned matchGroup(std::size_t group, std::int8_t byte) const {
+        const std::int8_t* g = this->ctrl.data() + group * GROUP_SIZE;
+#ifdef __SSE2__
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(byte)));
+#else
+        unsigned mask = 0;
+        for(std::size_t i = 0; i < GROUP_SIZE; i++)
+            mask |= unsigned(g[i] == byte) << i;
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Gets a bitmask with bit i set for every EMPTY or DELETED control byte in the group.
+     */
+    inline unsigned matchFree(std::size_t group) const {
+        const std::int8_t* g = this->ctrl.data() + group * GROUP_SIZE;
+#ifdef __SSE2__
+        /* Only EMPTY and DELETED have their sign bit set. */
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(g)));
+#else
+        unsigned mask = 0;
+        for(std::size_t i = 0; i < GROUP_SIZE; i++)
+            mask |= unsigned(g[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Finds the slot holding the specified key.
+     * @return The index of the slot, or NPOS if the key is absent.
+     */
+    inline std::size_t findIndex(const Coordinate& key) const {
+        if(this->count_ == 0)
+            return NPOS;
+
+        std::size_t h = cHash{}(key);
+        std::int8_t h2 = h & 0x7F;
+        std::size_t groupMask = this->ctrl.size() / GROUP_SIZE - 1;
+
+        /* Probe groups in triangular order; a group with an EMPTY byte ends the probe sequence. */
+        for(std::size_t group = (h >> 7) & groupMask, step = 1; ; group = (group + step++) & groupMask) {
+            for(unsigned match = matchGroup(group, h2); match != 0; match &= match - 1) {
+                std::size_t i = group * GROUP_SIZE + std::countr_zero(match);
+                if(this->slots[i].key == key)
+                    return i;
+            }
+            if(matchGroup(group, EMPTY) != 0)
+                return NPOS;
+        }
+    }
+
+    /**
+     * @brief Claims a free slot for a key known to be absent, growing the table if needed.
+     * @return The index of the claimed slot.
+     */
+    inline std::size_t insertIndex(const Coordinate& key) {
+        if((this->count_ + this->tombstones + 1) * 8 > capacity() * 7)
+            rehash(this->count_ + 1);
+
+        std::size_t h = cHash{}(key);
+        std::size_t groupMask = this->ctrl.size() / GROUP_SIZE - 1;
+
+        for(std::size_t group = (h >> 7) & groupMask, step = 1; ; group = (group + step++) & groupMask) {
+            if(unsigned free = matchFree(group); free != 0) {
+                std::size_t i = group * GROUP_SIZE + std::countr_zero(free);
+                if(this->ctrl[i] == DELETED)
+                    this->tombstones--;
+                this->ctrl[i] = h & 0x7F;
+                this->slots[i].key = key;
+                this->count_++;
+                return i;
+            }
+        }
+    }
+
+    /**
+     * @brief Reallocates the table to fit at least the specified number of entries, dropping tombstones.
+     * @param n The number of entries.
+     */
+    inline void rehash(std::size_t n) {
+        std::size_t newCapacity = GROUP_SIZE;
+        while(newCapacity * 7 < n * 8 * 2)
+            newCapacity *= 2;
+
+        std::vector<std::int8_t> oldCtrl(newCapacity, EMPTY);
+        std::vector<Slot> oldSlots(newCapacity);
+        oldCtrl.swap(this->ctrl);
+        oldSlots.swap(this->slots);
+        this->count_ = 0;
+        this->tombstones = 0;
+
+        for(std::size_t i = 0; i < oldCtrl.size(); i++) {
+            if(oldCtrl[i] >= 0)
+                this->slots[insertIndex(oldSlots[i].key)].value = oldSlots[i].value;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <string>
+
+/**
+ * @brief Formats a value as a CSV field, quoting it (and doubling its quotes) only if it contains a comma, quote
+ * or line break, so that plain values read the same as before.
+ * @param value The value.
+ * @return The CSV field.
+ */
+inline std::string csvField(const std::string& value) {
+    if(value.find_first_of(",\"\r\n") == std::string::npos)
+        return value;
+
+    std::string field = "\"";
+    for(char c : value) {
+        if(c == '"')
+            field += '"';
+        field += c;
+    }
+    return field + "\"";
+}
+
+#endif
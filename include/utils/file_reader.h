@@ -1,18 +1,15 @@
 #ifndef FILE_READER_H
 #define FILE_READER_H
 
-#include <fstream>
-#include <algorithm>
-#include <unordered_set>
-#include <unordered_map>
 #include <string>
-#include "coordinate.h"
-#include "hash.h"
+#include <string_view>
+#include "house_layout.h"
 
 /**
  * @brief A class declaration for reading input information about the house and robot from file.
  * 
- * The "FileReader" class exposes functions to the house and robot for initialization.
+ * The "FileReader" class maps the input file into memory once and parses it in a single forward pass,
+ * producing a "HouseLayout" that is shared by the house and robot for initialization.
  */
 class FileReader {
 public:
@@ -28,43 +25,36 @@ public:
     ~FileReader() {}
 
     /**
-     * @brief Reads the number of allocated steps for the robot's mission from file.
-     * @return The number of steps on success, -1 if invalid input or I/O error.
-    */
-    int readMaxSteps() const;
-
-    /**
-     * @brief Reads the battery capacity of the robot from file.
-     * @return The battery capacity on success, -1 if invalid input or I/O error.
+     * @brief Reads the mission parameters and house structure from file.
+     * @param layout The layout to store the parsed data into.
+     * @return true on success, false if invalid input or I/O error.
     */
-    int readMaxBattery() const;
+    bool readHouse(HouseLayout& layout) const;
 
-    /**
-     * @brief Reads the number of rows the house will have from file.
-     * @return The number of rows on success, -1 if invalid input or I/O error.
-    */
-    int readRowCount() const;
+private:
+    std::string infilePath; // The path to the input file.
 
     /**
-     * @brief Reads the number of columns the house will have from file.
-     * @return The number of columns on success, -1 if invalid input or I/O error.
+     * @brief Parses the mission parameters (Lines 2-5) and house structure (Line 6+) from the file contents.
+     * @param data The contents of the input file.
+     * @param layout The layout to store the parsed data into.
+     * @return true on success, false if invalid input.
     */
-    int readColCount() const;
+    bool parseHouse(std::string_view data, HouseLayout& layout) const;
 
     /**
-     * @brief Reads the house structure from file and stores the data into provided data structure references.
-     * @return true on success, false if invalid input or I/O error.
+     * @brief Parses out the value stored in Lines 2-5 if possible.
+     * @return The numeric value stored in the line on success, -1 if invalid input.
     */
-    bool readSpaces(std::unordered_set<Coordinate, cHash>& spaces, std::unordered_map<Coordinate, int, cHash>& dirtLevel) const;
-
-private:
-    std::string infilePath; // The path to the input file.
+    int parseLine(std::string_view line, std::string_view startsWith) const;
 
     /**
-     * @brief Parses out the value stored in Lines 2-5 if possible.
-     * @return The numeric value stored in the line on success, -1 if invalid input.
+     * @brief Splits the next line off of the remaining file contents.
+     * @param data The remaining file contents, advanced past the line on success.
+     * @param line The extracted line, without its line terminator.
+     * @return true on success, false if no lines remain.
     */
-    int parseLine(std::string line, std::string startsWith) const;
+    static bool nextLine(std::string_view& data, std::string_view& line);
 };
 
-#endif
\ No newline at end of file
+#endif
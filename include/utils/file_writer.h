@@ -1,8 +1,11 @@
 #ifndef FILE_WRITER_H
 #define FILE_WRITER_H
 
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include "direction.h"
 #include "step.h"
 #include "coordinate.h"
@@ -12,72 +15,98 @@
 /**
  * @brief A class declaration for writing mission results to file.
  * 
- * The "FileWriter" class exposes functions to the simulator for recording mission results.
+ * The "FileWriter" class exposes functions to the simulator for recording mission results. Steps are streamed to
+ * disk while the mission runs: they are recorded into one block while a background thread writes the previous
+ * block out, so memory stays constant however long the mission. The summary only becomes known once the mission
+ * ends, so steps are spilled to a side file and joined after the summary when the results are written.
  */
 class FileWriter {
 public:
     /**
      * @brief Constructs a "FileWriter" object.
+     * @param outfilePath The output file to write to.
      */
-    FileWriter() {}
+    FileWriter(std::string outfilePath = OFILE) : outfilePath(outfilePath), finished(false), pending(false), stopping(false), failed(false) {}
 
     /**
-     * @brief Destroys the created "FileWriter" object.
+     * @brief Destroys the created "FileWriter" object, discarding any steps spilled to disk.
     */
-    ~FileWriter() {}
+    ~FileWriter();
 
     /**
      * @brief Records step for result output.
      * @param s The step the robot made.
      */
     void recordStep(const Step s);
+
+    /**
+     * @brief Records the same step the specified number of times in a row for result output.
+     * @param s The step the robot made.
+     * @param times The number of times it was made.
+     */
+    void recordSteps(const Step s, std::size_t times);
     
     /**
      * @brief Writes results to output file.
      * @param totalSteps The number of steps the robot took throughout the mission.
      * @param dirtLeft The amount of remaining uncleaned dirt in the house at the end of the mission.
      * @param batteryLeft The amount of battery the robot has left at the end of the mission.
-     * @param loc The location of the robot at the end of the mission.
      * @return true on success, false if I/O error.
      */
-    bool recordResults(const int totalSteps, const int dirtLeft, const int batteryLeft) const;
+    bool recordResults(const int totalSteps, const int dirtLeft, const int batteryLeft);
 
-private:
-    std::string steps; // Maintains the list of steps the robot has taken.
-    
     /**
-     * @brief Sets up output file for I/O. 
-     * @return true on success, false if I/O error.
+     * @brief Determines the final status of the robot (FINISHED/WORKING/DEAD).
+     * @param batteryLeft The amount of battery the robot has left at the end of the mission.
+     * @return The status as it appears in the output file.
      */
-    bool setupOfile() const;
+    std::string getRobotStatus(const int batteryLeft) const;
 
     /**
-     * @brief Writes the total number of steps the robot took on the mission to output file.
-     * @param totalSteps The number of steps the robot took throughout the mission.
-     * @return true on success, false if I/O error.
+     * @brief Determines the final status of a robot (FINISHED/WORKING/DEAD) whose steps were not recorded.
+     * @param finished Whether the algorithm reported that the mission finished.
+     * @param batteryLeft The amount of battery the robot has left at the end of the mission.
+     * @return The status as it appears in the output file.
      */
-    bool writeStepCount(const int totalSteps) const; 
+    static std::string getRobotStatus(const bool finished, const int batteryLeft);
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 1 << 20;  // Steps recorded before a block is handed to the writer thread.
+
+    std::string outfilePath;            // The path to the output file.
+    std::string steps;                  // Steps recorded since the last block was handed off.
+    bool finished;                      // Whether the algorithm reported that the mission finished.
+
+    std::string block;                  // Block being written by the writer thread.
+    std::ofstream spill;                // Side file of steps written so far, only used once a block fills up.
+    std::thread writer;                 // The writer thread, started once the first block fills up.
+    std::mutex lock;                    // Guards pending, stopping and failed.
+    std::condition_variable changed;    // Signalled when a block is handed off, written, or the writer stops.
+    bool pending;                       // Whether block holds steps not yet written.
+    bool stopping;                      // Set when the writer thread should exit once block is written.
+    bool failed;                        // Set if steps could not be spilled.
 
     /**
-     * @brief Writes the remaining amount of dirt in the house to output file.
-     * @param dirtLeft The amount of remaining uncleaned dirt in the house at the end of the mission.
-     * @return true on success, false if I/O error.
+     * @brief Gets the path of the side file steps are spilled to.
+     * @return "<output file path>.steps".
      */
-    bool writeDirtLeft(const int dirtLeft) const;
+    std::string spillPath() const;
 
     /**
-     * @brief Writes the final status of the robot (FINISHED/WORKING/DEAD).
-     * @param batteryLeft The amount of battery the robot has left at the end of the mission.
-     * @param loc The location of the robot at the end of the mission.
-     * @return true on success, false if I/O error.
+     * @brief Hands the recorded steps to the writer thread as a block, waiting for the previous block to be written
+     * first, and starts the writer thread on first use.
      */
-    bool writeRobotStatus(const int batteryLeft) const;
+    void handOff();
 
     /**
-     * @brief Writes the steps that the robot took on the mission.
-     * @return true on success, false if I/O error.
+     * @brief Writes blocks to the side file until stopped.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Stops the writer thread once every block handed off is written, and closes the side file.
      */
-    bool writeSteps() const;
+    void stopWriter();
 };
 
 #endif
\ No newline at end of file
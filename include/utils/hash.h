@@ -2,44 +2,30 @@
 #define HASH_H
 
 #include <cstddef>
+#include <cstdint>
 #include "coordinate.h"
-#include "node.h"
 
 /**
  * @brief An struct declaration for hashing coordinates.
- * 
+ *
  * Use this struct to provide a hashing function for the custom coordinate object.
  */
 struct cHash
-{       
+{
     /**
      * @brief Hashing function for coordinates.
-     * https://stackoverflow.com/questions/682438/hash-function-providing-unique-uint-from-an-integer-coordinate-pair
-     * 
+     * Packs (x, y) into 64 bits and runs the result through the splitmix64 finalizer, so that every
+     * input bit affects every output bit, including for small and negative coordinates.
+     *
      * @param c The coordinate object to hash.
      * @return The hash of the coordinate as a size_t.
      */
     std::size_t operator() (const Coordinate& c) const {
-        return (c.x * 0x1f1f1f1f) ^ c.y;
+        std::uint64_t h = (std::uint64_t(std::uint32_t(c.x)) << 32) | std::uint32_t(c.y);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
     }
 };
 
-
-/**
- * @brief An struct declaration for hashing nodes.
- * 
- * Use this struct to provide a hashing function for the custom node object.
- */
-struct nHash {
-    /**
-     * @brief Hashing function for nodes.
-     * https://stackoverflow.com/questions/682438/hash-function-providing-unique-uint-from-an-integer-coordinate-pair
-     * 
-     * @param n The node object to hash.
-     * @return The hash of the node as a size_t.
-     */
-    std::size_t operator()(const std::shared_ptr<Node>& n) const {
-        return std::hash<const void*>{}(n.get());
-    }
-};
-#endif
\ No newline at end of file
+#endif
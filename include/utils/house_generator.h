@@ -0,0 +1,143 @@
+#ifndef HOUSE_GENERATOR_H
+#define HOUSE_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include "dirt_style.h"
+#include "house_layout.h"
+#include "house_style.h"
+
+/**
+ * @brief A struct declaration for the parameters of a generated house.
+ */
+struct GeneratorOptions {
+    int rows;              // The number of rows in the house, including its outer walls.
+    int cols;              // The number of columns in the house, including its outer walls.
+    HouseStyle style;      // The structure of the house.
+    DirtStyle dirt;        // The dirt distribution of the house.
+    double dirtDensity;    // The fraction of free spaces that are dirty, on average.
+    double wallDensity;    // The fraction of spaces of an open house that are pillars.
+    int roomSize;          // The side length of the block each room of a rooms house is laid out in.
+    int dockRow;           // The preferred row of the charging dock, or -1 for a random row.
+    int dockCol;           // The preferred column of the charging dock, or -1 for a random column.
+    int maxSteps;          // The mission budget, or 0 to derive it from the house size.
+    int maxBattery;        // The battery capacity, or 0 to derive it from the house size.
+    std::uint64_t seed;    // The seed all randomness is derived from.
+
+    /**
+     * @brief Constructs a "GeneratorOptions" object with default values.
+     */
+    GeneratorOptions() : rows(0), cols(0), style(HouseStyle::Open), dirt(DirtStyle::Uniform), dirtDensity(0.5),
+                         wallDensity(0), roomSize(12), dockRow(-1), dockCol(-1), maxSteps(0), maxBattery(0), seed(0) {}
+};
+
+/**
+ * @brief A class declaration for generating synthetic houses.
+ *
+ * The "HouseGenerator" class builds houses surrounded by walls, as open halls, perfect mazes, or rooms joined by
+ * corridors. Every space is derived from a hash of the seed and its position only, never from a sequential random
+ * stream, so the same options always produce the same house and bands of rows are generated in parallel.
+ */
+class HouseGenerator {
+public:
+    /**
+     * @brief Constructs a "HouseGenerator" object.
+     * @param options The parameters of the houses to generate.
+     */
+    HouseGenerator(GeneratorOptions options) : options(options) {}
+
+    /**
+     * @brief Destroys a "HouseGenerator" object.
+     */
+    ~HouseGenerator() {}
+
+    /**
+     * @brief Generates the house. The charging dock is placed on the free space closest to the preferred one.
+     * @param layout The layout to store the house into.
+     */
+    void generate(HouseLayout& layout) const;
+
+    /**
+     * @brief Writes a house in the input file format read by "FileReader".
+     * @param layout The house.
+     * @param name The name of the house, written on the first line.
+     * @param path The file to write.
+     * @return true on success, false if I/O error.
+     */
+    static bool write(const HouseLayout& layout, const std::string name, const std::string path);
+
+    /**
+     * @brief Gets the name of a house style, as accepted by parseStyle().
+     */
+    static const char* styleName(const HouseStyle style);
+
+    /**
+     * @brief Parses the name of a house style ("open", "maze" or "rooms").
+     * @param name The name.
+     * @param style The style to store the result into.
+     * @return true on success, false if the name is not a house style.
+     */
+    static bool parseStyle(const std::string& name, HouseStyle& style);
+
+private:
+    static constexpr int ROWS_PER_TASK = 64;   // Rows generated or written by one thread-pool task.
+    static constexpr int NOISE_SCALE = 32;     // Side length of the lattice clustered dirt is interpolated over.
+
+    GeneratorOptions options;                  // The parameters of the houses to generate.
+
+    /**
+     * @brief Hashes a position and a salt together with the seed.
+     * @return A uniformly distributed 64-bit hash.
+     */
+    std::uint64_t hash(const std::int64_t a, const std::int64_t b, const std::uint64_t salt) const;
+
+    /**
+     * @brief Maps a hash uniformly onto [0, n).
+     */
+    static std::uint32_t bounded(const std::uint64_t h, const std::uint32_t n);
+
+    /**
+     * @brief Hashes a position and a salt together with the seed into [0, 1).
+     */
+    double unit(const std::int64_t a, const std::int64_t b, const std::uint64_t salt) const;
+
+    /**
+     * @brief Checks if the specified space is free (not a wall), according to the house style.
+     */
+    bool isFree(const int row, const int col) const;
+
+    /**
+     * @brief Checks if the specified space of a perfect maze is free. Mazes are built row by row (Sidewinder).
+     */
+    bool isFreeMaze(const int row, const int col) const;
+
+    /**
+     * @brief Checks if the specified space of a rooms house is free.
+     */
+    bool isFreeRooms(const int row, const int col) const;
+
+    /**
+     * @brief Checks if the specified room of a rooms house is joined to the room east of it.
+     */
+    bool linkedEast(const int blockRow, const int blockCol) const;
+
+    /**
+     * @brief Checks if the specified room of a rooms house is joined to the room south of it.
+     */
+    bool linkedSouth(const int blockRow, const int blockCol) const;
+
+    /**
+     * @brief Generates one row of the house: walls according to the house style, and dirt on every free space
+     * according to the dirt style.
+     * @param row The row.
+     * @param cells The cells of the row.
+     */
+    void fillRow(const int row, signed char* cells) const;
+
+    /**
+     * @brief Places the charging dock on the free space closest to the preferred one, freeing it if none exists.
+     */
+    void placeDock(HouseLayout& layout) const;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef HOUSE_LAYOUT_H
+#define HOUSE_LAYOUT_H
+
+#include <vector>
+#include "coordinate.h"
+
+/**
+ * @brief A struct declaration for the parsed contents of a house file.
+ * 
+ * The "HouseLayout" struct is filled in once by the "FileReader" and is then handed read-only to the house and robot
+ * for initialization. Cells are stored row-major in file order, with the charging dock located at (dockRow, dockCol).
+ */
+struct HouseLayout {
+    static constexpr signed char WALL = -1;   // Cell value used to mark a wall.
+
+    int maxSteps;                             // The number of steps allocated to the robot for the mission.
+    int maxBattery;                           // The battery capacity of the robot.
+    int rows;                                 // The number of rows in the house.
+    int cols;                                 // The number of columns in the house.
+    int dockRow;                              // The row of the charging dock.
+    int dockCol;                              // The column of the charging dock.
+    std::vector<signed char> cells;           // The dirt level of each cell, or WALL.
+
+    /**
+     * @brief Constructs an empty "HouseLayout" object.
+     */
+    HouseLayout() : maxSteps(0), maxBattery(0), rows(0), cols(0), dockRow(0), dockCol(0) {}
+
+    /**
+     * @brief Gets the value stored in the specified cell.
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return The dirt level of the cell, or WALL.
+     */
+    inline signed char at(int row, int col) const { return this->cells[row * this->cols + col]; }
+
+    /**
+     * @brief Converts the specified cell into a location relative to the charging dock (origin).
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return The location of the cell.
+     */
+    inline Coordinate toCoordinate(int row, int col) const { return Coordinate(col - this->dockCol, this->dockRow - row); }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstdint>
+#include <ostream>
+#include "latency_histogram.h"
+
+/**
+ * @brief Runs the enclosed statements only in builds configured with -DROBOT_INSTRUMENT=ON.
+ * Otherwise they compile to nothing, and so do the counters they update.
+ */
+#ifdef ROBOT_INSTRUMENT
+#define INSTRUMENT(...) __VA_ARGS__
+#else
+#define INSTRUMENT(...)
+#endif
+
+/**
+ * @brief A struct declaration for the counters kept by the algorithm over a mission.
+ */
+struct AlgorithmStats {
+    std::uint64_t searches;           // Breadth-first searches for the closest unvisited node.
+    std::uint64_t nodesExpanded;      // Nodes dequeued by those searches.
+    std::uint64_t searchQueuePeak;    // Most nodes queued at once by a single search.
+    std::uint64_t frontierPeak;       // Most unvisited nodes known at once.
+    std::uint64_t distanceUpdates;    // Nodes whose distance from the dock shrank as the map grew.
+    std::uint64_t batteryReplans;     // Returns to the dock triggered by the battery check.
+    std::uint64_t budgetReplans;      // Returns to the dock triggered by the mission budget check.
+    std::uint64_t exploredReplans;    // Returns to the dock because no unvisited node was left.
+
+    /**
+     * @brief Constructs an "AlgorithmStats" object with every counter at 0.
+     */
+    AlgorithmStats() : searches(0), nodesExpanded(0), searchQueuePeak(0), frontierPeak(0), distanceUpdates(0),
+                       batteryReplans(0), budgetReplans(0), exploredReplans(0) {}
+
+    /**
+     * @brief Writes every counter as a JSON object.
+     * @param out The stream to write to.
+     */
+    void writeJson(std::ostream& out) const;
+};
+
+/**
+ * @brief A struct declaration for the counters kept by the simulator over a mission.
+ */
+struct SimulationStats {
+    std::uint64_t moveSteps;             // Steps moving to another space.
+    std::uint64_t cleaningSteps;         // Steps staying off the dock.
+    std::uint64_t chargingSteps;         // Steps staying on the dock.
+    LatencyHistogram nextStepLatency;    // Wall time of each plan requested from the algorithm's nextSteps(), in nanoseconds.
+
+    /**
+     * @brief Constructs a "SimulationStats" object with every counter at 0.
+     */
+    SimulationStats() : moveSteps(0), cleaningSteps(0), chargingSteps(0) {}
+
+    /**
+     * @brief Writes every counter, the latency histogram summary and the algorithm's counters as a JSON object.
+     * @param out The stream to write to.
+     * @param algorithm The algorithm's counters for the same mission.
+     */
+    void writeJson(std::ostream& out, const AlgorithmStats& algorithm) const;
+};
+
+#endif
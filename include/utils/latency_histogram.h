@@ -0,0 +1,75 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief A class declaration for a histogram of latencies, in the style of HdrHistogram.
+ *
+ * The "LatencyHistogram" class buckets values log-linearly: every power of two is split into SUB_BUCKETS / 2
+ * equal buckets, so any recorded value is reported to within 1/64 (about 1.6%) of its true value, over the whole
+ * 64-bit range, in a fixed-size array. Recording is a count-leading-zeros and an increment.
+ */
+class LatencyHistogram {
+public:
+    /**
+     * @brief Constructs an empty "LatencyHistogram" object.
+     */
+    LatencyHistogram() : counts(BUCKETS, 0), total(0), sum(0), min(UINT64_MAX), max(0) {}
+
+    /**
+     * @brief Destroys a "LatencyHistogram" object.
+     */
+    ~LatencyHistogram() {}
+
+    /**
+     * @brief Records a value.
+     * @param value The value.
+     */
+    void record(const std::uint64_t value);
+
+    /**
+     * @brief Gets the value at the specified percentile.
+     * @param percentile The percentile, in [0, 100].
+     * @return The highest value equivalent to the percentile's bucket, capped at the maximum recorded value, or 0 if empty.
+     */
+    std::uint64_t valueAtPercentile(const double percentile) const;
+
+    /**
+     * @brief Checks for the number of recorded values.
+     * @return The number of values.
+     */
+    std::uint64_t getCount() const;
+
+    /**
+     * @brief Writes count, min, mean, p50, p90, p99, p99.9 and max as a JSON object.
+     * @param out The stream to write to.
+     */
+    void writeJson(std::ostream& out) const;
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 7;                          // Bits of precision kept per value.
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;           // Buckets holding the exact values below it.
+    static constexpr int HALF = SUB_BUCKETS / 2;                       // Buckets per power of two above SUB_BUCKETS.
+    static constexpr int BUCKETS = (64 - SUB_BUCKET_BITS + 2) * HALF;  // Buckets covering every 64-bit value.
+
+    std::vector<std::uint64_t> counts;   // The number of values recorded in each bucket.
+    std::uint64_t total;                 // The number of values recorded.
+    std::uint64_t sum;                   // The sum of values recorded.
+    std::uint64_t min;                   // The smallest value recorded.
+    std::uint64_t max;                   // The largest value recorded.
+
+    /**
+     * @brief Gets the bucket holding the specified value.
+     */
+    static int bucketOf(const std::uint64_t value);
+
+    /**
+     * @brief Gets the highest value held by the specified bucket.
+     */
+    static std::uint64_t highestIn(const int bucket);
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef NODE_MAP_H
+#define NODE_MAP_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "coordinate.h"
+#include "direction.h"
+
+using NodeId = std::uint32_t;   // Index of a node within the node map.
+
+/**
+ * @brief A class declaration for the algorithm's map of the house.
+ *
+ * The "NodeMap" class stores every mapped node as a slot in a set of parallel arrays, so that scans over a
+ * single attribute (e.g. visited flags or dirt levels) stream through memory. Each node has four neighbor
+ * slots in N/E/S/W order, with a bitmask recording which of them are linked.
+ */
+class NodeMap {
+public:
+    static constexpr int UNREACHED = std::numeric_limits<int>::max();     // Distance of a node not yet connected to the dock.
+    static constexpr NodeId NONE = std::numeric_limits<NodeId>::max();    // ID that refers to no node.
+
+    /**
+     * @brief Constructs an empty "NodeMap" object.
+     */
+    NodeMap() {}
+
+    /**
+     * @brief Destroys a "NodeMap" object.
+     */
+    ~NodeMap() {}
+
+    /**
+     * @brief Appends a new, unvisited and unlinked node. Nodes are never removed, so IDs stay valid.
+     * @param coords The location of the node, relative to the charging dock (origin).
+     * @return The ID of the new node.
+     */
+    inline NodeId addNode(Coordinate coords) {
+        NodeId id = this->coords.size();
+        this->coords.push_back(coords);
+        this->dirtLevel.push_back(0);
+        this->visited.push_back(false);
+        this->distFromDock.push_back(UNREACHED);
+        this->neighborMask.push_back(0);
+        this->neighbors.push_back({NONE, NONE, NONE, NONE});
+        return id;
+    }
+
+    /**
+     * @brief Links two adjacent nodes in both directions.
+     * @param node The first node.
+     * @param d The direction from the first node to the second.
+     * @param neighbor The second node.
+     */
+    inline void link(NodeId node, Direction d, NodeId neighbor) {
+        int opposite = (static_cast<int>(d) + 2) % 4;
+        this->neighbors[node][static_cast<int>(d)] = neighbor;
+        this->neighborMask[node] |= 1 << static_cast<int>(d);
+        this->neighbors[neighbor][opposite] = node;
+        this->neighborMask[neighbor] |= 1 << opposite;
+    }
+
+    /**
+     * @brief Calls f(neighbor) for every linked neighbor of the node, in N/E/S/W order.
+     * @param node The node whose neighbors to visit.
+     * @param f The callable to invoke.
+     */
+    template <typename F>
+    inline void forEachNeighbor(NodeId node, F f) const {
+        unsigned char mask = this->neighborMask[node];
+        const std::array<NodeId, 4>& slots = this->neighbors[node];
+        for(int d = 0; d < 4; d++) {
+            if(mask & (1 << d))
+                f(slots[d]);
+        }
+    }
+
+    /* Setter methods */
+    inline void setDirtLevel(NodeId node, int dirtLevel) { this->dirtLevel[node] = dirtLevel; }
+    inline void decrementDirtLevel(NodeId node) { this->dirtLevel[node]--; }
+    inline void setVisited(NodeId node) { this->visited[node] = true; }
+    inline void setDistFromDock(NodeId node, int distFromDock) { this->distFromDock[node] = distFromDock; }
+
+    /* Getter methods */
+    inline std::size_t size() const { return this->coords.size(); }
+    inline Coordinate getCoords(NodeId node) const { return this->coords[node]; }
+    inline int getEuclidianDist(NodeId node) const { return this->coords[node].x * this->coords[node].x + this->coords[node].y * this->coords[node].y; }
+    inline int getDirtLevel(NodeId node) const { return this->dirtLevel[node]; }
+    inline bool isVisited(NodeId node) const { return this->visited[node]; }
+    inline int getDistFromDock(NodeId node) const { return this->distFromDock[node]; }
+    inline bool hasNeighbor(NodeId node, Direction d) const { return this->neighborMask[node] & (1 << static_cast<int>(d)); }
+
+private:
+    std::vector<Coordinate> coords;                     // Location of each node.
+    std::vector<int> dirtLevel;                         // Last known dirt level of each node.
+    std::vector<unsigned char> visited;                 // Whether each node has been stood on.
+    std::vector<int> distFromDock;                      // Exact shortest known distance from each node to the dock.
+    std::vector<unsigned char> neighborMask;            // Bit "static_cast<int>(Direction)" set for each linked neighbor slot.
+    std::vector<std::array<NodeId, 4>> neighbors;       // Neighbor slots of each node, in N/E/S/W order.
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef NODE_SET_H
+#define NODE_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "node_map.h"
+
+/**
+ * @brief A class declaration for a set of node IDs.
+ *
+ * The "NodeSet" class stores membership as a dense bitset over node IDs, so membership tests and updates
+ * are a single bit operation. Members are also kept in a compact list, so enumerating the set only touches
+ * its members rather than every mapped node.
+ */
+class NodeSet {
+public:
+    /**
+     * @brief Constructs an empty "NodeSet" object.
+     */
+    NodeSet() {}
+
+    /**
+     * @brief Destroys a "NodeSet" object.
+     */
+    ~NodeSet() {}
+
+    /**
+     * @brief Checks if the specified node is a member.
+     * @param node The node to check.
+     * @return true if the node is a member, otherwise false.
+     */
+    inline bool contains(NodeId node) const {
+        std::size_t word = node / 64;
+        return word < this->bits.size() && (this->bits[word] >> (node % 64) & 1);
+    }
+
+    /**
+     * @brief Adds the specified node, if not already a member.
+     * @param node The node to add.
+     */
+    inline void insert(NodeId node) {
+        if(contains(node))
+            return;
+
+        if(node / 64 >= this->bits.size())
+            this->bits.resize(node / 64 + 1, 0);
+        if(node >= this->position.size())
+            this->position.resize(node + 1);
+
+        this->bits[node / 64] |= std::uint64_t(1) << (node % 64);
+        this->position[node] = this->members.size();
+        this->members.push_back(node);
+    }
+
+    /**
+     * @brief Removes the specified node, if a member.
+     * @param node The node to remove.
+     */
+    inline void erase(NodeId node) {
+        if(!contains(node))
+            return;
+
+        this->bits[node / 64] &= ~(std::uint64_t(1) << (node % 64));
+
+        /* Move the last member into the removed member's place in the list. */
+        NodeId last = this->members.back();
+        this->members[this->position[node]] = last;
+        this->position[last] = this->position[node];
+        this->members.pop_back();
+    }
+
+    /**
+     * @brief Removes every member for which pred(member) returns true.
+     * @param pred The predicate to test members with.
+     */
+    template <typename F>
+    inline void eraseIf(F pred) {
+        for(std::size_t i = this->members.size(); i-- > 0;) {
+            if(pred(this->members[i]))
+                erase(this->members[i]);
+        }
+    }
+
+    inline std::size_t size() const { return this->members.size(); }
+    inline bool empty() const { return this->members.empty(); }
+    inline const std::vector<NodeId>& list() const { return this->members; }
+
+private:
+    std::vector<std::uint64_t> bits;                    // Bit (node % 64) of word (node / 64) is set for every member.
+    std::vector<NodeId> members;                        // Compact list of members, in unspecified order.
+    std::vector<std::uint32_t> position;                // Index of each member within the list.
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef PERF_PROFILER_H
+#define PERF_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "perf_phase.h"
+
+/**
+ * @brief A class declaration for attributing hardware performance counters to phases of a mission.
+ *
+ * The "PerfProfiler" class opens one Linux perf_event_open group counting, for the calling thread in user space,
+ * cycles, instructions, cache misses, branch misses and task clock. Each phase reads the whole group once on entry
+ * and once on exit, and accumulates the difference, scaled up if the kernel had to multiplex counters. Counters
+ * the machine does not support (e.g. hardware events inside most VMs) are reported as null.
+ */
+class PerfProfiler {
+public:
+    static constexpr int COUNTERS = 5;   // Cycles, instructions, cache misses, branch misses, task clock (ns).
+
+    /**
+     * @brief Constructs a "PerfProfiler" object with no counters open.
+     */
+    PerfProfiler();
+
+    /**
+     * @brief Destroys a "PerfProfiler" object, closing its counters.
+     */
+    ~PerfProfiler();
+
+    /**
+     * @brief Opens and starts the counters.
+     * @return true if at least one counter could be opened, otherwise false (e.g. not Linux, or forbidden by
+     * /proc/sys/kernel/perf_event_paranoid).
+     */
+    bool open();
+
+    /**
+     * @brief Marks the start of a phase. Phases of different kinds may nest, but a phase may not nest in itself.
+     * @param phase The phase.
+     */
+    void begin(const PerfPhase phase);
+
+    /**
+     * @brief Marks the end of a phase, and adds the counts since its start to the phase's totals.
+     * @param phase The phase.
+     */
+    void end(const PerfPhase phase);
+
+    /**
+     * @brief Writes the totals of every phase entered at least once as JSON.
+     * @param out The stream to write to.
+     */
+    void writeJson(std::ostream& out) const;
+
+private:
+    /**
+     * @brief A struct declaration for the counts read at one instant, or accumulated over a phase.
+     */
+    struct Sample {
+        std::array<std::uint64_t, COUNTERS> values;   // The value of each counter.
+        std::uint64_t enabled;                        // Time the group was enabled.
+        std::uint64_t running;                        // Time the group was actually counting.
+        std::chrono::steady_clock::time_point wall;   // Wall clock.
+    };
+
+    /**
+     * @brief A struct declaration for the totals of one phase.
+     */
+    struct Totals {
+        std::uint64_t calls;                          // Number of times the phase was entered.
+        std::array<double, COUNTERS> values;          // Scaled counter totals.
+        std::uint64_t wallNs;                         // Wall time.
+    };
+
+    int leader;                                                         // The group leader, or -1 if none is open.
+    std::array<int, COUNTERS> fds;                                      // The descriptor of each counter, or -1.
+    std::array<int, COUNTERS> slots;                                    // The position of each counter in group reads, or -1.
+    int opened;                                                         // Number of counters open.
+    std::array<Sample, static_cast<int>(PerfPhase::Count)> starts;      // The sample taken when each phase was entered.
+    std::array<Totals, static_cast<int>(PerfPhase::Count)> totals;      // The totals of each phase.
+
+    /**
+     * @brief Reads every counter of the group at once.
+     * @param sample The sample to fill.
+     */
+    void read(Sample& sample) const;
+};
+
+/**
+ * @brief A class declaration for profiling a scope as a phase.
+ *
+ * The "PerfScope" class begins the phase on construction and ends it on destruction. It does nothing when
+ * given no profiler, so call sites cost a single branch when profiling is off.
+ */
+class PerfScope {
+public:
+    /**
+     * @brief Constructs a "PerfScope" object, beginning the phase.
+     * @param profiler The profiler, or nullptr when not profiling.
+     * @param phase The phase.
+     */
+    PerfScope(PerfProfiler* profiler, const PerfPhase phase) : profiler(profiler), phase(phase) {
+        if(this->profiler)
+            this->profiler->begin(phase);
+    }
+
+    /**
+     * @brief Destroys a "PerfScope" object, ending the phase.
+     */
+    ~PerfScope() {
+        if(this->profiler)
+            this->profiler->end(this->phase);
+    }
+
+private:
+    PerfProfiler* profiler;   // The profiler, or nullptr when not profiling.
+    PerfPhase phase;          // The phase.
+};
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef STEP_TRACE_H
+#define STEP_TRACE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "step.h"
+
+#define STEP_TRACE_MAGIC "RBSTEPS"
+
+/**
+ * @brief A struct declaration for the header of a binary step trace.
+ *
+ * A trace file is laid out as, all integers little-endian:
+ *   - the header, HEADER_SIZE bytes: magic (8), version (u32), maxSteps (u32), maxBattery (u32), index interval
+ *     (u32), number of steps (u64), offset of the seek index (u64), number of index entries (u64), dirt left (i32),
+ *     status (u8, 0 FINISHED, 1 WORKING, 2 DEAD) and 3 bytes of padding;
+ *   - the records, one byte each optionally followed by a varint:
+ *       0aaabbb0           two single steps, codes aaa then bbb, where bbb = 7 is padding (no step);
+ *       1cccnnnn           a run of nnnn + 3 steps of code ccc, for nnnn < 15;
+ *       1ccc1111 <varint>  a run of varint + 18 steps of code ccc, the varint in LEB128;
+ *     where step codes follow the order of the Step enum (N, E, S, W, s, F);
+ *   - the seek index: pairs of (step, record offset) (u64, u64), each the first step of a record, at least an
+ *     index interval of steps apart.
+ */
+struct StepTraceHeader {
+    static constexpr int HEADER_SIZE = 56;          // Size of the header in the file.
+    static constexpr std::uint32_t VERSION = 1;     // Version of the format.
+
+    int maxSteps;                   // The number of steps allocated to the robot for the mission.
+    int maxBattery;                 // The battery capacity of the robot.
+    std::uint32_t indexInterval;    // The minimum number of steps between index entries.
+    std::uint64_t numSteps;         // The number of steps in the trace.
+    std::uint64_t indexOffset;      // The offset of the seek index in the file.
+    std::uint64_t indexCount;       // The number of entries in the seek index.
+    int dirtLeft;                   // The amount of remaining uncleaned dirt in the house at the end of the mission.
+    std::string status;             // The final status of the robot (FINISHED/WORKING/DEAD).
+};
+
+/**
+ * @brief A class declaration for writing a mission's steps as a compact binary trace.
+ *
+ * The "StepTraceWriter" class packs single steps at 3 bits each and run-length-encodes repeated steps, such as
+ * the long stretches of cleaning and charging and straight corridor runs. Records are streamed to disk in blocks,
+ * so memory stays constant apart from the seek index, and the header is patched in once the mission ends.
+ */
+class StepTraceWriter {
+public:
+    static constexpr std::uint32_t INDEX_INTERVAL = 1 << 16;    // Steps between seek index entries.
+
+    /**
+     * @brief Constructs a "StepTraceWriter" object.
+     * @param traceFilePath The trace file to write to.
+     */
+    StepTraceWriter(std::string traceFilePath) : traceFilePath(traceFilePath) {}
+
+    /**
+     * @brief Destroys a "StepTraceWriter" object.
+     */
+    ~StepTraceWriter() {}
+
+    /**
+     * @brief Creates the trace file, reserving room for its header.
+     * @param maxSteps The number of steps allocated to the robot for the mission.
+     * @param maxBattery The battery capacity of the robot.
+     * @return true on success, false if I/O error.
+     */
+    bool open(const int maxSteps, const int maxBattery);
+
+    /**
+     * @brief Records a step.
+     * @param s The step the robot made.
+     */
+    void recordStep(const Step s);
+
+    /**
+     * @brief Records the same step the specified number of times in a row, extending the pending run at once.
+     * @param s The step the robot made.
+     * @param times The number of times it was made.
+     */
+    void recordSteps(const Step s, const std::uint64_t times);
+
+    /**
+     * @brief Writes the remaining records and the seek index, then patches in the header.
+     * @param dirtLeft The amount of remaining uncleaned dirt in the house at the end of the mission.
+     * @param status The final status of the robot (FINISHED/WORKING/DEAD).
+     * @return true on success, false if I/O error.
+     */
+    bool close(const int dirtLeft, const std::string status);
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 1 << 16;          // Bytes buffered before each write to disk.
+
+    std::string traceFilePath;                                  // The path to the trace file.
+    std::ofstream out;                                          // The trace file.
+    StepTraceHeader header;                                     // The header, completed on close.
+
+    std::vector<unsigned char> block;                           // Records not yet written to disk.
+    std::uint64_t offset;                                       // Offset of the next record in the file.
+    std::uint64_t stepsEncoded;                                 // Steps in every record before the next one.
+    std::uint64_t nextIndexStep;                                // Step from which the next index entry is due.
+    std::vector<std::uint64_t> index;                           // Seek index, as step and offset pairs.
+
+    int runCode;                                                // Code of the pending run, or -1 if none.
+    std::uint64_t runLength;                                    // Length of the pending run.
+    int literalCode;                                            // Code of a single step awaiting its pair, or -1.
+
+    /**
+     * @brief Encodes the pending run, as a run record if long enough, otherwise as single steps.
+     */
+    void flushRun();
+
+    /**
+     * @brief Encodes a single step, pairing it with the step awaiting its pair if any.
+     * @param code The code of the step.
+     */
+    void emitLiteral(const int code);
+
+    /**
+     * @brief Writes a step awaiting its pair on its own, padded.
+     */
+    void flushLiteral();
+
+    /**
+     * @brief Starts a record, adding a seek index entry if one is due.
+     */
+    void beginRecord();
+
+    /**
+     * @brief Appends a byte to the block, writing the block to disk when full.
+     * @param byte The byte.
+     */
+    void put(const unsigned char byte);
+
+    /**
+     * @brief Writes the block to disk.
+     */
+    void flushBlock();
+};
+
+/**
+ * @brief A class declaration for reading a binary step trace.
+ *
+ * The "StepTraceReader" class decodes a trace written by "StepTraceWriter" one run at a time, so consumers can
+ * handle repeated steps in bulk, and uses the seek index to start from any step without decoding the ones before.
+ */
+class StepTraceReader {
+public:
+    /**
+     * @brief Constructs a "StepTraceReader" object.
+     * @param traceFilePath The trace file to read.
+     */
+    StepTraceReader(std::string traceFilePath) : traceFilePath(traceFilePath) {}
+
+    /**
+     * @brief Destroys a "StepTraceReader" object.
+     */
+    ~StepTraceReader() {}
+
+    /**
+     * @brief Opens the trace file and reads its header and seek index, positioned at the first step.
+     * @return true on success, false if I/O error or not a valid trace.
+     */
+    bool open();
+
+    /**
+     * @brief Gets the header of the trace.
+     * @return The header.
+     */
+    const StepTraceHeader& getHeader() const;
+
+    /**
+     * @brief Positions the reader so that the next run starts at the specified step.
+     * @param step The step, counted from 0.
+     * @return true on success, false if the step is past the end of the trace or I/O error.
+     */
+    bool seek(const std::uint64_t step);
+
+    /**
+     * @brief Reads the next run of identical steps. Runs are not necessarily maximal.
+     * @param s The step repeated throughout the run.
+     * @param length The number of steps in the run.
+     * @return true on success, false at the end of the trace or if the trace is corrupt.
+     */
+    bool nextRun(Step& s, std::uint64_t& length);
+
+    /**
+     * @brief Appends steps as text (N/E/S/W/s/F) to a string.
+     * @param steps The string to append to.
+     * @param count The maximum number of steps to append.
+     * @return The number of steps appended, fewer than count only at the end of the trace.
+     */
+    std::uint64_t readText(std::string& steps, const std::uint64_t count);
+
+private:
+    std::string traceFilePath;                  // The path to the trace file.
+    std::ifstream in;                           // The trace file.
+    StepTraceHeader header;                     // The header of the trace.
+    std::vector<std::uint64_t> index;           // Seek index, as step and offset pairs.
+
+    std::uint64_t offset;                       // Offset of the next record in the file.
+    std::uint64_t position;                     // Step the next run starts at.
+    int pendingCode;                            // Code of a decoded run not yet returned, or -1.
+    std::uint64_t pendingLength;                // Length of the decoded run not yet returned.
+    int pairedCode;                             // Code of the second step of a literal pair not yet returned, or -1.
+
+    /**
+     * @brief Moves to a record in the file and forgets any decoded steps.
+     * @param offset The offset of the record.
+     * @param step The first step of the record.
+     */
+    void moveTo(const std::uint64_t offset, const std::uint64_t step);
+
+    /**
+     * @brief Decodes the next record into the pending run and the paired step.
+     * @return true on success, false at the end of the records or if the trace is corrupt.
+     */
+    bool decodeRecord();
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A class declaration for a work-stealing thread pool.
+ *
+ * The "ThreadPool" class gives each worker thread its own task queue. Workers take tasks from the back of their
+ * own queue, and once it runs dry, steal from the front of the other workers' queues, so that uneven tasks
+ * (e.g. houses of very different sizes) still keep every core busy.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructs a "ThreadPool" object and starts its worker threads.
+     * @param threadCount The number of worker threads, defaults to the number of hardware threads.
+     */
+    ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+    /**
+     * @brief Destroys a "ThreadPool" object after waiting for every submitted task to finish.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Queues a task to be run by one of the worker threads.
+     * @param task The task to run.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     */
+    void wait();
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The number of worker threads.
+     */
+    std::size_t size() const;
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;                            // Guards the tasks of this queue.
+        std::deque<std::function<void()>> tasks;    // Tasks owned by one worker, stolen from the front by others.
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // One queue per worker thread.
+    std::vector<std::thread> threads;                   // The worker threads.
+    std::atomic<std::size_t> nextQueue;                 // Round-robin queue for tasks submitted from outside the pool.
+    std::atomic<long> queued;                           // Number of tasks sitting in a queue.
+
+    std::mutex stateLock;                               // Guards pending and stopping, and backs both condition variables.
+    std::condition_variable taskAvailable;              // Signalled when a task is queued or the pool stops.
+    std::condition_variable allDone;                    // Signalled when the last pending task finishes.
+    std::size_t pending;                                // Number of tasks submitted but not yet finished.
+    bool stopping;                                      // Set when the pool is shutting down.
+
+    /**
+     * @brief Runs tasks on a worker thread until the pool stops.
+     * @param index The index of the worker.
+     */
+    void workerLoop(std::size_t index);
+
+    /**
+     * @brief Takes a task from the worker's own queue, or steals one from another worker.
+     * @param index The index of the worker.
+     * @param task The task taken, on success.
+     * @return true if a task was taken, otherwise false.
+     */
+    bool takeTask(std::size_t index, std::function<void()>& task);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A class declaration for recording a timeline of a mission in the Chrome trace event format.
+ *
+ * The "TraceWriter" class buffers one complete ("X") event per span in memory, each tagged with the step of the
+ * mission it happened at, and writes them as a JSON trace that chrome://tracing and Perfetto can open.
+ */
+class TraceWriter {
+public:
+    /**
+     * @brief Constructs an empty "TraceWriter" object. Timestamps are relative to its construction.
+     */
+    TraceWriter() : origin(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Destroys a "TraceWriter" object.
+     */
+    ~TraceWriter() {}
+
+    /**
+     * @brief Records a span.
+     * @param name The name of the span. Must outlive the trace writer, e.g. a string literal.
+     * @param category The category of the span. Must outlive the trace writer, e.g. a string literal.
+     * @param start When the span started.
+     * @param end When the span ended.
+     * @param step The step of the mission the span started at, or -1 if outside the mission.
+     * @param steps The number of steps the span covers, or 0 if it is within a single step.
+     */
+    void complete(const char* name, const char* category, std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end, const int step, const int steps = 0);
+
+    /**
+     * @brief Writes every recorded span to file.
+     * @param traceFilePath The location of the file to write.
+     * @return true on success, false if I/O error.
+     */
+    bool write(const std::string traceFilePath) const;
+
+private:
+    /**
+     * @brief A struct declaration for a recorded span.
+     */
+    struct Event {
+        const char* name;        // The name of the span.
+        const char* category;    // The category of the span.
+        std::int64_t startNs;    // Start, relative to the origin.
+        std::int64_t durationNs; // Duration.
+        int step;                // The step the span started at, or -1.
+        int steps;               // The number of steps covered, or 0.
+    };
+
+    std::chrono::steady_clock::time_point origin;   // Time 0 of the trace.
+    std::vector<Event> events;                      // Recorded spans, in order of completion.
+};
+
+/**
+ * @brief A class declaration for recording a scope as a span.
+ *
+ * The "TraceScope" class records the span from its construction to its destruction. It does nothing when given no
+ * trace writer, so call sites cost a single branch when tracing is off.
+ */
+class TraceScope {
+public:
+    /**
+     * @brief Constructs a "TraceScope" object, starting the span.
+     * @param tracer The trace writer, or nullptr when not tracing.
+     * @param name The name of the span.
+     * @param category The category of the span.
+     * @param step The step of the mission, or -1 if outside the mission.
+     */
+    TraceScope(TraceWriter* tracer, const char* name, const char* category, const int step)
+        : tracer(tracer), name(name), category(category), step(step) {
+        if(this->tracer)
+            this->start = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Destroys a "TraceScope" object, recording the span.
+     */
+    ~TraceScope() {
+        if(this->tracer)
+            this->tracer->complete(this->name, this->category, this->start, std::chrono::steady_clock::now(), this->step);
+    }
+
+private:
+    TraceWriter* tracer;                            // The trace writer, or nullptr when not tracing.
+    const char* name;                               // The name of the span.
+    const char* category;                           // The category of the span.
+    int step;                                       // The step of the mission, or -1.
+    std::chrono::steady_clock::time_point start;    // When the span started.
+};
+
+#endif
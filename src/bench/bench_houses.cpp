@@ -0,0 +1,24 @@
+#include "bench_houses.h"
+
+#include <filesystem>
+
+HouseLayout BenchHouses::make(const HouseStyle shape, const int size) {
+    GeneratorOptions o;
+    o.rows = o.cols = size;
+    o.style = shape;
+    o.roomSize = 9;
+    o.dockRow = o.dockCol = 1;
+    o.maxBattery = 4 * size + 40;
+    o.maxSteps = 4 * size * size;
+    o.seed = size;
+
+    HouseLayout layout;
+    HouseGenerator(o).generate(layout);
+    return layout;
+}
+
+std::string BenchHouses::tempPath(const std::string name) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "robot_bench";
+    std::filesystem::create_directories(dir);
+    return (dir / name).string();
+}
@@ -0,0 +1,279 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+bool BenchmarkState::keepRunning() {
+    if(!this->started) {
+        this->started = true;
+        resumeTiming();
+    }
+    if(this->remaining-- > 0)
+        return true;
+
+    if(!this->paused)
+        pauseTiming();
+    return false;
+}
+
+void BenchmarkState::pauseTiming() {
+    this->realNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->realStart).count();
+    this->cpuNs += threadCpuNs() - this->cpuStart;
+    this->paused = true;
+}
+
+void BenchmarkState::resumeTiming() {
+    this->paused = false;
+    this->cpuStart = threadCpuNs();
+    this->realStart = std::chrono::steady_clock::now();
+}
+
+std::int64_t BenchmarkState::range(std::size_t index) const {
+    return this->args[index];
+}
+
+std::int64_t BenchmarkState::getIterations() const {
+    return this->iterations;
+}
+
+void BenchmarkState::setItemsProcessed(std::int64_t items) {
+    this->itemsProcessed = items;
+}
+
+void BenchmarkState::setBytesProcessed(std::int64_t bytes) {
+    this->bytesProcessed = bytes;
+}
+
+void BenchmarkState::setLabel(std::string label) {
+    this->label = label;
+}
+
+std::int64_t BenchmarkState::threadCpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+Benchmark* Benchmark::arg(std::int64_t a) {
+    this->instances.push_back({a});
+    return this;
+}
+
+Benchmark* Benchmark::args(std::vector<std::int64_t> a) {
+    this->instances.push_back(a);
+    return this;
+}
+
+Benchmark* Benchmark::argNames(std::vector<std::string> names) {
+    this->names = names;
+    return this;
+}
+
+std::deque<Benchmark>& BenchmarkRunner::registry() {
+    static std::deque<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+Benchmark* BenchmarkRunner::registerBenchmark(std::string name, std::function<void(BenchmarkState&)> fn) {
+    registry().emplace_back(name, fn);
+    return &registry().back();
+}
+
+BenchmarkRunner::Result BenchmarkRunner::runInstance(const Benchmark& b, const std::vector<std::int64_t>& args, std::string name, double minTime) {
+    /* Grow the iteration count until a single run lasts at least minTime, as Google Benchmark does. */
+    std::int64_t iterations = 1;
+    while(true) {
+        BenchmarkState state(iterations, args);
+        b.fn(state);
+
+        double seconds = state.realNs / 1e9;
+        if(seconds >= minTime || iterations >= 1000000000) {
+            Result r;
+            r.name = name;
+            r.iterations = state.iterations;
+            r.realNs = double(state.realNs) / state.iterations;
+            r.cpuNs = double(state.cpuNs) / state.iterations;
+            r.itemsPerSecond = seconds > 0 ? state.itemsProcessed / seconds : 0;
+            r.bytesPerSecond = seconds > 0 ? state.bytesProcessed / seconds : 0;
+            r.label = state.label;
+            r.counters = state.counters;
+            return r;
+        }
+
+        /* Overshoot the estimate slightly, but never grow more than tenfold at once. */
+        double multiplier = seconds > 0 ? minTime * 1.4 / seconds : 10;
+        multiplier = std::clamp(multiplier, 2.0, 10.0);
+        iterations = std::int64_t(iterations * multiplier);
+    }
+}
+
+void BenchmarkRunner::writeJson(std::ostream& out, const std::vector<Result>& results) {
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+    std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    /* Names only hold [A-Za-z0-9_/:.-], so no escaping is needed except in labels. */
+    auto quote = [](const std::string& s) {
+        std::string q = "\"";
+        for(char c : s) {
+            if(c == '"' || c == '\\')
+                q += '\\';
+            q += c;
+        }
+        return q + "\"";
+    };
+
+    out << std::setprecision(17);
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": " << quote(date) << ",\n";
+    out << "    \"host_name\": " << quote(host) << ",\n";
+    out << "    \"executable\": \"robot_bench\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n  \"benchmarks\": [\n";
+    for(size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << "    {\n";
+        out << "      \"name\": " << quote(r.name) << ",\n";
+        out << "      \"run_name\": " << quote(r.name) << ",\n";
+        out << "      \"run_type\": \"iteration\",\n";
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"real_time\": " << r.realNs << ",\n";
+        out << "      \"cpu_time\": " << r.cpuNs << ",\n";
+        out << "      \"time_unit\": \"ns\"";
+        if(r.itemsPerSecond > 0)
+            out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+        if(r.bytesPerSecond > 0)
+            out << ",\n      \"bytes_per_second\": " << r.bytesPerSecond;
+        for(const auto& [key, value] : r.counters)
+            out << ",\n      " << quote(key) << ": " << value;
+        if(!r.label.empty())
+            out << ",\n      \"label\": " << quote(r.label);
+        out << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void BenchmarkRunner::writeConsole(std::ostream& out, const std::vector<Result>& results) {
+    size_t width = 9;
+    for(const Result& r : results)
+        width = std::max(width, r.name.size());
+
+    out << std::left << std::setw(width) << "Benchmark" << std::right << std::setw(15) << "Time" << std::setw(15) << "CPU"
+        << std::setw(13) << "Iterations" << " UserCounters..." << std::endl;
+    out << std::string(width + 43 + 16, '-') << std::endl;
+    for(const Result& r : results) {
+        out << std::left << std::setw(width) << r.name << std::right << std::fixed << std::setprecision(0)
+            << std::setw(12) << r.realNs << " ns" << std::setw(12) << r.cpuNs << " ns" << std::setw(13) << r.iterations;
+        out << std::defaultfloat << std::setprecision(4);
+        if(r.itemsPerSecond > 0)
+            out << " items_per_second=" << r.itemsPerSecond;
+        if(r.bytesPerSecond > 0)
+            out << " bytes_per_second=" << r.bytesPerSecond;
+        for(const auto& [key, value] : r.counters)
+            out << " " << key << "=" << value;
+        if(!r.label.empty())
+            out << " " << r.label;
+        out << std::endl;
+    }
+}
+
+int BenchmarkRunner::main(int argc, char** argv) {
+    std::string filter = ".";
+    std::string format = "console";
+    std::string outPath;
+    double minTime = 0.5;
+    bool list = false;
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&arg](const std::string& flag, std::string& v) {
+            if(arg.rfind(flag + "=", 0) != 0)
+                return false;
+            v = arg.substr(flag.size() + 1);
+            return true;
+        };
+        std::string v;
+        if(value("--benchmark_filter", v))
+            filter = v;
+        else if(value("--benchmark_format", v) && (v == "console" || v == "json"))
+            format = v;
+        else if(value("--benchmark_out", v))
+            outPath = v;
+        else if(value("--benchmark_min_time", v))
+            minTime = std::atof(v.c_str());
+        else if(arg == "--benchmark_list_tests")
+            list = true;
+        else {
+            std::cerr << "USAGE: ./robot_bench [--benchmark_filter=<regex>] [--benchmark_format=console|json] "
+                      << "[--benchmark_out=<file>] [--benchmark_min_time=<seconds>] [--benchmark_list_tests]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::regex re;
+    try {
+        re = std::regex(filter);
+    }
+    catch(const std::regex_error&) {
+        std::cerr << "Invalid benchmark filter: " << filter << std::endl;
+        return 1;
+    }
+
+    /* Expand every benchmark into its named instances, keeping registration order. */
+    std::vector<Result> results;
+    for(const Benchmark& b : registry()) {
+        std::vector<std::vector<std::int64_t>> instances = b.instances;
+        if(instances.empty())
+            instances.push_back({});
+
+        for(const std::vector<std::int64_t>& args : instances) {
+            std::string name = b.name;
+            for(size_t i = 0; i < args.size(); i++)
+                name += "/" + (i < b.names.size() ? b.names[i] + ":" : "") + std::to_string(args[i]);
+            if(!std::regex_search(name, re))
+                continue;
+
+            if(list) {
+                std::cout << name << std::endl;
+                continue;
+            }
+            results.push_back(runInstance(b, args, name, minTime));
+        }
+    }
+    if(list)
+        return 0;
+
+    if(format == "json")
+        writeJson(std::cout, results);
+    else
+        writeConsole(std::cout, results);
+
+    /* The output file is always JSON, for comparison across commits. */
+    if(!outPath.empty()) {
+        std::ofstream f(outPath);
+        writeJson(f, results);
+        if(f.fail()) {
+            std::cerr << "Unable to write benchmark output file: " << outPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    return BenchmarkRunner::main(argc, argv);
+}
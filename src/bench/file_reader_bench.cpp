@@ -0,0 +1,36 @@
+#include <filesystem>
+#include "bench_houses.h"
+#include "benchmark.h"
+#include "file_reader.h"
+#include "house.h"
+
+/* Parses a rooms house of the given side length from file. */
+static void BM_FileReaderReadHouse(BenchmarkState& state) {
+    int size = state.range(0);
+    std::string path = BenchHouses::tempPath("read_" + std::to_string(size) + ".txt");
+    HouseGenerator::write(BenchHouses::make(HouseStyle::Rooms, size), "Benchmark house", path);
+
+    FileReader fr(path);
+    HouseLayout layout;
+    while(state.keepRunning())
+        fr.readHouse(layout);
+
+    state.setBytesProcessed(state.getIterations() * std::filesystem::file_size(path));
+    state.counters["cells"] = double(size) * size;
+}
+
+/* Builds the simulator's house from an already parsed layout. */
+static void BM_HouseSetup(BenchmarkState& state) {
+    int size = state.range(0);
+    HouseLayout layout = BenchHouses::make(HouseStyle::Rooms, size);
+
+    while(state.keepRunning()) {
+        House h;
+        h.houseSetup(layout);
+    }
+
+    state.setItemsProcessed(state.getIterations() * size * size);
+}
+
+BENCHMARK(BM_FileReaderReadHouse)->argNames({"size"})->arg(64)->arg(256)->arg(1024)->arg(4096);
+BENCHMARK(BM_HouseSetup)->argNames({"size"})->arg(64)->arg(256)->arg(1024)->arg(4096);
@@ -0,0 +1,139 @@
+#include <map>
+#include <memory>
+#include "bench_houses.h"
+#include "benchmark.h"
+#include "concrete_algorithm.h"
+#include "simulation.h"
+
+/**
+ * @brief A class declaration for benchmarking the planner's searches in isolation.
+ *
+ * The "PlannerBench" class drives a mission halfway through a benchmark house, then repeatedly runs a single
+ * planner search on the resulting map. It is a friend of "ConcreteAlgorithm" to reach the searches directly.
+ */
+class PlannerBench {
+public:
+    /**
+     * @brief Benchmarks the walk down the distance field from the node farthest from the dock.
+     */
+    static void findPathToDock(BenchmarkState& state);
+
+    /**
+     * @brief Benchmarks the bounded breadth-first search for the closest unvisited node.
+     */
+    static void setClosestNonAdjacentNodePath(BenchmarkState& state);
+
+private:
+    /**
+     * @brief A struct declaration for a half-explored mission. Kept alive, as the algorithm points to its sensors.
+     */
+    struct Fixture {
+        House h;
+        Robot r;
+        ConcreteBatteryMeter bm;
+        ConcreteDirtSensor ds;
+        ConcreteWallsSensor ws;
+        ConcreteAlgorithm algo;
+    };
+
+    /**
+     * @brief Gets the half-explored mission for a house, building it on first use.
+     * @param shape The shape of the house.
+     * @param size The side length of the house.
+     * @return The mission.
+     */
+    static const Fixture& fixture(const HouseStyle shape, const int size);
+};
+
+const PlannerBench::Fixture& PlannerBench::fixture(const HouseStyle shape, const int size) {
+    static std::map<std::pair<HouseStyle, int>, std::unique_ptr<Fixture>> fixtures;
+    std::unique_ptr<Fixture>& f = fixtures[{shape, size}];
+    if(f)
+        return *f;
+
+    HouseLayout layout = BenchHouses::make(shape, size);
+    f = std::make_unique<Fixture>();
+    f->h.houseSetup(layout);
+    f->r.robotSetup(layout);
+    f->algo.setMaxSteps(layout.maxSteps);
+    f->algo.setBatteryMeter(f->bm);
+    f->algo.setDirtSensor(f->ds);
+    f->algo.setWallsSensor(f->ws);
+
+    /* Measure the whole mission once, to stop the benchmarked one halfway. */
+    Simulation<> s(BenchHouses::tempPath("planner_output.txt"));
+    s.setHouse(f->h, layout.maxSteps, layout.maxBattery);
+    s.setAlgorithm(ConcreteSpecializedAlgorithm());
+    s.run();
+    int halfway = s.getSummary().numSteps / 2;
+
+    /* Same loop as Simulation::run. */
+    while(f->r.getStepCount() < halfway) {
+        Coordinate currLoc = f->r.getLoc();
+        unsigned char walls = f->h.getWalls(currLoc);
+        f->bm.setBatteryState(f->r.getBatteryLeft());
+        f->ds.setDirtLevel(f->h.getDirt(currLoc));
+        for(Direction d : {Direction::North, Direction::West, Direction::South, Direction::East})
+            f->ws.setWall(walls & (1 << static_cast<int>(d)), d);
+
+        Step nextStep = f->algo.nextStep();
+        f->r.move(nextStep);
+        if(nextStep == Step::Stay)
+            f->h.cleanSpace(f->r.getLoc());
+    }
+    return *f;
+}
+
+void PlannerBench::findPathToDock(BenchmarkState& state) {
+    HouseStyle shape = static_cast<HouseStyle>(state.range(0));
+    ConcreteAlgorithm algo = fixture(shape, state.range(1)).algo;
+
+    NodeId farthest = 0;
+    for(NodeId node = 0; node < algo.nodes.size(); node++) {
+        int dist = algo.nodes.getDistFromDock(node);
+        if(dist != NodeMap::UNREACHED && dist > algo.nodes.getDistFromDock(farthest))
+            farthest = node;
+    }
+
+    std::vector<NodeId> path;
+    while(state.keepRunning())
+        algo.findPathToDock(farthest, path);
+
+    state.setLabel(HouseGenerator::styleName(shape));
+    state.counters["nodes"] = algo.nodes.size();
+    state.counters["path"] = path.size();
+    state.setItemsProcessed(state.getIterations() * path.size());
+}
+
+void PlannerBench::setClosestNonAdjacentNodePath(BenchmarkState& state) {
+    HouseStyle shape = static_cast<HouseStyle>(state.range(0));
+    ConcreteAlgorithm algo = fixture(shape, state.range(1)).algo;
+
+    /* As when the planner runs the search for real, the robot's own node has already been cleaned. */
+    NodeId curr = algo.houseMap[algo.robotCoords];
+    if(algo.unvisitedNodes.contains(curr))
+        algo.unvisitedNodes.erase(curr);
+
+    /* The first search drops unreachable nodes, every later one sees the same map. */
+    algo.setClosestNonAdjacentNodePath();
+    while(state.keepRunning())
+        algo.setClosestNonAdjacentNodePath();
+
+    state.setLabel(HouseGenerator::styleName(shape));
+    state.counters["nodes"] = algo.nodes.size();
+    state.counters["unvisited"] = algo.unvisitedNodes.size();
+    state.counters["path"] = algo.pathToNode.size();
+}
+
+static void BM_FindPathToDock(BenchmarkState& state) {
+    PlannerBench::findPathToDock(state);
+}
+
+static void BM_SetClosestNonAdjacentNodePath(BenchmarkState& state) {
+    PlannerBench::setClosestNonAdjacentNodePath(state);
+}
+
+BENCHMARK(BM_FindPathToDock)->argNames({"shape", "size"})
+    ->args({0, 64})->args({0, 256})->args({1, 64})->args({1, 256})->args({2, 64})->args({2, 256});
+BENCHMARK(BM_SetClosestNonAdjacentNodePath)->argNames({"shape", "size"})
+    ->args({0, 64})->args({0, 256})->args({1, 64})->args({1, 256})->args({2, 64})->args({2, 256});
@@ -0,0 +1,73 @@
+#include <memory>
+#include "bench_houses.h"
+#include "benchmark.h"
+#include "simulation.h"
+
+/* Runs a whole mission on an already parsed house, including writing its output file. */
+template <typename Sim, typename Algo>
+static void runSimulation(BenchmarkState& state) {
+    HouseStyle shape = static_cast<HouseStyle>(state.range(0));
+    HouseLayout layout = BenchHouses::make(shape, state.range(1));
+    House house;
+    house.houseSetup(layout);
+    std::string outputPath = BenchHouses::tempPath("simulation_output.txt");
+
+    MissionSummary summary;
+    while(state.keepRunning()) {
+        state.pauseTiming();
+        std::unique_ptr<Sim> s = std::make_unique<Sim>(outputPath);
+        s->setHouse(house, layout.maxSteps, layout.maxBattery);
+        s->setAlgorithm(Algo());
+        state.resumeTiming();
+
+        s->run();
+
+        state.pauseTiming();
+        summary = s->getSummary();
+        s.reset();
+        state.resumeTiming();
+    }
+
+    state.setLabel(HouseGenerator::styleName(shape));
+    state.counters["steps"] = summary.numSteps;
+    state.setItemsProcessed(state.getIterations() * summary.numSteps);
+}
+
+/* The algorithm reads the sensors directly. */
+static void BM_SimulationRun(BenchmarkState& state) {
+    runSimulation<Simulation<>, ConcreteSpecializedAlgorithm>(state);
+}
+
+/* The algorithm reads the sensors through their abstract interfaces. */
+static void BM_AbstractSimulationRun(BenchmarkState& state) {
+    runSimulation<AbstractSimulation, ConcreteAlgorithm>(state);
+}
+
+/* Runs a whole mission end to end, as main() does: parse the house file, simulate and write the output file. */
+static void BM_Mission(BenchmarkState& state) {
+    HouseStyle shape = static_cast<HouseStyle>(state.range(0));
+    int size = state.range(1);
+    std::string housePath = BenchHouses::tempPath(std::string("mission_") + HouseGenerator::styleName(shape) + "_" + std::to_string(size) + ".txt");
+    HouseGenerator::write(BenchHouses::make(shape, size), "Benchmark house", housePath);
+    std::string outputPath = BenchHouses::tempPath("mission_output.txt");
+
+    MissionSummary summary;
+    while(state.keepRunning()) {
+        Simulation<> s(outputPath);
+        s.readHouseFile(housePath);
+        s.setAlgorithm(ConcreteSpecializedAlgorithm());
+        s.run();
+        summary = s.getSummary();
+    }
+
+    state.setLabel(HouseGenerator::styleName(shape));
+    state.counters["steps"] = summary.numSteps;
+    state.setItemsProcessed(state.getIterations() * summary.numSteps);
+}
+
+BENCHMARK(BM_SimulationRun)->argNames({"shape", "size"})
+    ->args({0, 32})->args({0, 128})->args({1, 32})->args({1, 128})->args({2, 32})->args({2, 128});
+BENCHMARK(BM_AbstractSimulationRun)->argNames({"shape", "size"})
+    ->args({0, 32})->args({0, 128})->args({1, 32})->args({1, 128})->args({2, 32})->args({2, 128});
+BENCHMARK(BM_Mission)->argNames({"shape", "size"})
+    ->args({0, 32})->args({0, 128})->args({1, 32})->args({1, 128})->args({2, 32})->args({2, 128});
@@ -16,6 +16,14 @@ void ConcreteAlgorithm::setWallsSensor(const WallsSensor &wallsSensor) {
     this->ws = &wallsSensor;
 }
 
+void ConcreteAlgorithm::setProfiler(PerfProfiler* profiler) {
+    this->profiler = profiler;
+}
+
+void ConcreteAlgorithm::setTracer(TraceWriter* tracer) {
+    this->tracer = tracer;
+}
+
 bool ConcreteAlgorithm::onChargingDock() {
     return this->robotCoords.x == 0 && this->robotCoords.y == 0;
 }
@@ -23,15 +31,77 @@ bool ConcreteAlgorithm::onChargingDock() {
 Step ConcreteAlgorithm::nextStep() {
     /* Perform necessary setup before computing next step. */
     setup();
+    return computeStep();
+}
+
+size_t ConcreteAlgorithm::nextSteps(Step* steps, const size_t maxSteps) {
+    if(maxSteps == 0)
+        return 0;
+    setup();
+    return planSteps(steps, maxSteps);
+}
+
+size_t ConcreteAlgorithm::planSteps(Step* steps, const size_t maxSteps) {
+    /* The sensors were just read, and the map updated, for the first step. */
+    size_t count = 0;
+    steps[count++] = computeStep();
 
-    /* Get current node and dock node. */
-    std::shared_ptr<Node> dock = this->houseMap[Coordinate(0, 0)];
-    std::shared_ptr<Node> curr = this->houseMap[this->robotCoords];
+    /* Keep planning for as long as the sensors can be predicted from the map, up to a stay. */
+    while(count < maxSteps && steps[count - 1] != Step::Finish && steps[count - 1] != Step::Stay && predictSensors(steps[count - 1])) {
+        updateMap();
+        steps[count++] = computeStep();
+    }
+    return count;
+}
+
+size_t ConcreteAlgorithm::repeatStay(const size_t maxStays) {
+    /* The robot does not stay on an empty battery. */
+    if(this->batteryLeft < 0)
+        return 0;
+
+    NodeId curr = this->houseMap[this->robotCoords];
+    long long stays;
+    if(onChargingDock()) {
+        /* Charge until the battery reads full, or until the step before the budget runs out, when it finishes. */
+        int rate = this->batteryCap / 20;
+        stays = static_cast<long long>(this->missionBudget) - 1 - this->stepCount;
+        if(rate > 0)
+            stays = std::min<long long>(stays, (this->batteryCap - this->batteryLeft + rate - 1) / rate - 1);
+    }
+    else {
+        /* Clean until the space is clean, or until the budget or battery are only just enough to return. */
+        int dist = this->nodes.getDistFromDock(curr);
+        stays = std::min<long long>(this->nodes.getDirtLevel(curr), static_cast<long long>(this->missionBudget) - this->stepCount - dist - 2);
+        stays = std::min<long long>(stays, this->batteryLeft - dist - 2);
+    }
+    stays = std::clamp<long long>(stays, 0, maxStays);
+    if(stays == 0)
+        return 0;
+
+    /* Leave the state as the last of the stays would. */
+    this->stepCount += static_cast<int>(stays);
+    if(onChargingDock())
+        this->batteryLeft = static_cast<int>(std::min<long long>(this->batteryLeft + stays * (this->batteryCap / 20), this->batteryCap));
+    else {
+        int dirtLeft = this->nodes.getDirtLevel(curr) - static_cast<int>(stays);
+        if(dirtLeft == 0)
+            this->unvisitedNodes.erase(curr);
+        this->batteryLeft -= static_cast<int>(stays);
+        this->dirt = dirtLeft + 1;
+        this->nodes.setDirtLevel(curr, dirtLeft);
+    }
+    return static_cast<size_t>(stays);
+}
+
+Step ConcreteAlgorithm::computeStep() {
+    /* Get current node. */
+    NodeId curr = this->houseMap[this->robotCoords];
+    INSTRUMENT(this->stats.frontierPeak = std::max<std::uint64_t>(this->stats.frontierPeak, this->unvisitedNodes.size());)
     
     /* EXIT CONDITIONS */
 
     /* Return finish when no more dirt is cleanable OR the mission budget has been exhausted and robot returned to charging dock. */
-    if((this->unvisitedNodes.size() == 0 || this->missionBudget - 1 == this->stepCount) && onChargingDock()) {
+    if((this->unvisitedNodes.empty() || this->missionBudget - 1 == this->stepCount) && onChargingDock()) {
         return Step::Finish;
     }
 
@@ -47,58 +117,45 @@ Step ConcreteAlgorithm::nextStep() {
     }
 
     /* There are no nodes left to explore, return to dock. */
-    if(this->unvisitedNodes.size() == 0) {
-        this->pathToDock = this->findShortestPath(curr, dock);
+    if(this->unvisitedNodes.empty()) {
+        INSTRUMENT(this->stats.exploredReplans++;)
+        findPathToDock(curr, this->pathToDock);
         return returnToDock();
     }
 
     /* If on a space with no dirt, immediately remove it from the list of nodes to visit. */
-    if(curr->getDirtLevel() == 0 && this->unvisitedNodes.count(curr) == 1) 
+    if(this->nodes.getDirtLevel(curr) == 0 && this->unvisitedNodes.contains(curr)) 
         this->unvisitedNodes.erase(curr);
 
-    /* Estimation indicates that that the robot may have just enough mission budget to return (upper-bounded). */
-    if(!onChargingDock() && this->missionBudget <= this->stepCount + this->distFromDock + 1) {
-        auto path = findShortestPath(curr, dock);
-        
-        /* If actual distance confirms the estimate, return to dock. */
-        if(this->missionBudget <= this->stepCount + path.size() + 1) {
-            this->pathToDock = path;
-            return returnToDock();
-        }
-        /* If the actual distance does not confirm the estimate, continue exploration. */
-        else 
-            this->distFromDock = path.size();
+    /* The robot has just enough mission budget to return, return to dock. */
+    if(!onChargingDock() && this->missionBudget <= this->stepCount + this->nodes.getDistFromDock(curr) + 1) {
+        INSTRUMENT(this->stats.budgetReplans++;)
+        findPathToDock(curr, this->pathToDock);
+        return returnToDock();
     }
 
-    /* Estimation indicates that the robot may have just enough battery to return (upper-bounded). */
-    if(!onChargingDock() && this->batteryLeft <= this->distFromDock + 1) {
-        auto path = findShortestPath(curr, dock);
-        
-        /* If actual distance aligns with estimate, return to dock, otherwise continue. */
-        if(this->batteryLeft <= path.size() + 1){ 
-            this->pathToDock = path;
-            return returnToDock();
-        }
-        else 
-            this->distFromDock = path.size();
-    }   
+    /* The robot has just enough battery to return, return to dock. */
+    if(!onChargingDock() && this->batteryLeft <= this->nodes.getDistFromDock(curr) + 1) {
+        INSTRUMENT(this->stats.batteryReplans++;)
+        findPathToDock(curr, this->pathToDock);
+        return returnToDock();
+    }
 
     /* CHARGING AND CLEANING */
 
     /* If on charging dock, always fully charge. */
     if(onChargingDock() && this->batteryLeft != this->batteryCap) {
-        this->distFromDock = 0;
-        this->pathToNode = std::stack<std::shared_ptr<Node>>();
+        this->pathToNode.clear();
         return Step::Stay;
     }
 
     /* If on a space with dirt, always clean. */
-    if(curr->getDirtLevel() != 0) {
+    if(this->nodes.getDirtLevel(curr) != 0) {
         /* Immediately remove space from list of nodes to visit once dirt level is 0. */
-        if(curr->getDirtLevel() == 1) 
+        if(this->nodes.getDirtLevel(curr) == 1) 
             this->unvisitedNodes.erase(curr);
 
-        curr->decrementDirtLevel();
+        this->nodes.decrementDirtLevel(curr);
         return Step::Stay;
     }
 
@@ -111,8 +168,8 @@ Step ConcreteAlgorithm::nextStep() {
     }
 
     /* Traverse the closest adjacent node, if it exists. */
-    std::shared_ptr<Node> neighbor = getClosestAdjacentNode();
-    if(neighbor)
+    NodeId neighbor = getClosestAdjacentNode();
+    if(neighbor != NodeMap::NONE)
         return getDirectionToNode(neighbor);
 
     /* Traverse the closest non-adjacent node. */
@@ -122,25 +179,52 @@ Step ConcreteAlgorithm::nextStep() {
 
 void ConcreteAlgorithm::setup() {
     /* Pull data from sensors. */   
-    this->batteryLeft = dynamic_cast<const ConcreteBatteryMeter *>(this->bm)->getBatteryState();
-    this->dirt = dynamic_cast<const ConcreteDirtSensor *>(this->ds)->dirtLevel();
-    this->wallNorth = dynamic_cast<const ConcreteWallsSensor *>(this->ws)->isWall(Direction::North);
-    this->wallWest = dynamic_cast<const ConcreteWallsSensor *>(this->ws)->isWall(Direction::West);
-    this->wallSouth = dynamic_cast<const ConcreteWallsSensor *>(this->ws)->isWall(Direction::South);
-    this->wallEast = dynamic_cast<const ConcreteWallsSensor *>(this->ws)->isWall(Direction::East);
+    this->batteryLeft = this->bm->getBatteryState();
+    this->dirt = this->ds->dirtLevel();
+    this->wallNorth = this->ws->isWall(Direction::North);
+    this->wallWest = this->ws->isWall(Direction::West);
+    this->wallSouth = this->ws->isWall(Direction::South);
+    this->wallEast = this->ws->isWall(Direction::East);
+    updateMap();
+}
+
+bool ConcreteAlgorithm::predictSensors(Step s) {
+    /* The robot does not move on an empty battery, so the map no longer follows it. */
+    if(this->batteryLeft < 0)
+        return false;
+
+    /* Only a visited space has its walls and dirt mapped. */
+    NodeId curr = this->houseMap[this->robotCoords];
+    if(!this->nodes.isVisited(curr))
+        return false;
+
+    /* Any move costs battery except staying on dock, and the dock charges whatever the step. */
+    if(s != Step::Stay || !onChargingDock())
+        this->batteryLeft--;
+    if(onChargingDock())
+        this->batteryLeft = std::min(this->batteryLeft + this->batteryCap / 20, this->batteryCap);
+
+    this->dirt = this->nodes.getDirtLevel(curr);
+    this->wallNorth = !this->nodes.hasNeighbor(curr, Direction::North);
+    this->wallWest = !this->nodes.hasNeighbor(curr, Direction::West);
+    this->wallSouth = !this->nodes.hasNeighbor(curr, Direction::South);
+    this->wallEast = !this->nodes.hasNeighbor(curr, Direction::East);
+    return true;
+}
 
+void ConcreteAlgorithm::updateMap() {
     /* Initialize some class attributes on first run. */
     if(this->stepCount == 0) {
         this->batteryCap = this->batteryLeft;
 
-        std::shared_ptr<Node> dockPtr = std::make_shared<Node>(robotCoords);
-        this->houseMap.insert(std::make_pair(robotCoords, dockPtr));
+        NodeId dock = addNode(this->robotCoords);
+        this->nodes.setDistFromDock(dock, 0);
     }
 
     /* Set current node to visited. */
-    std::shared_ptr<Node> curr = this->houseMap[this->robotCoords];
-    curr->setVisited();
-    curr->setDirtLevel(this->dirt);
+    NodeId curr = this->houseMap[this->robotCoords];
+    this->nodes.setVisited(curr);
+    this->nodes.setDirtLevel(curr, this->dirt);
 
     /* Map neighbors of the current node. */
     markSurroundings();
@@ -149,99 +233,116 @@ void ConcreteAlgorithm::setup() {
 void ConcreteAlgorithm::markSurroundings() {
     /* If north/south/east/west neighbor not mapped, add it to house map. */
     if(!this->wallNorth)
-        mapNeighbor(Coordinate(this->robotCoords.x, this->robotCoords.y + 1));
+        mapNeighbor(Coordinate(this->robotCoords.x, this->robotCoords.y + 1), Direction::North);
     if(!this->wallWest)
-        mapNeighbor(Coordinate(this->robotCoords.x - 1, this->robotCoords.y));
+        mapNeighbor(Coordinate(this->robotCoords.x - 1, this->robotCoords.y), Direction::West);
     if(!this->wallSouth)
-        mapNeighbor(Coordinate(this->robotCoords.x, this->robotCoords.y - 1));
+        mapNeighbor(Coordinate(this->robotCoords.x, this->robotCoords.y - 1), Direction::South);
     if(!this->wallEast)
-        mapNeighbor(Coordinate(this->robotCoords.x + 1, this->robotCoords.y));
+        mapNeighbor(Coordinate(this->robotCoords.x + 1, this->robotCoords.y), Direction::East);
 }
 
-void ConcreteAlgorithm::mapNeighbor(Coordinate coords) {
+void ConcreteAlgorithm::mapNeighbor(Coordinate coords, Direction d) {
     /* Add neighbor to house map, if not already mapped. */
-    if(this->houseMap.count(coords) == 0) {
-        std::shared_ptr<Node> neighbor = std::make_shared<Node>(coords);
-        this->houseMap.insert(std::make_pair(coords, neighbor));
-    }
+    if(this->houseMap.count(coords) == 0)
+        addNode(coords);
 
-    /* Add neighbor to current node's list of neighbors, if not already present. */
-    std::shared_ptr<Node> curr = this->houseMap[this->robotCoords];
-    std::shared_ptr<Node> neighbor = this->houseMap[coords];
-    auto neighbors = curr->getNeighbors();
-
-    bool found = false;
-    for(int i = 0; i < neighbors.size(); i++) {
-        if(neighbors[i]->getCoords() == coords) {
-            found = true;
-            break;
-        }    
+    /* Link neighbor to the current node in both directions, if not already linked. */
+    NodeId curr = this->houseMap[this->robotCoords];
+    NodeId neighbor = this->houseMap[coords];
+
+    if(!this->nodes.hasNeighbor(curr, d)) {
+        this->nodes.link(curr, d, neighbor);
+        updateDistFromDock(curr, neighbor);
     }
-    if(!found)
-        curr->addNeighbor(neighbor);
     
     /* Add neighbor to list of nodes to clean. */
-    if(this->unvisitedNodes.count(neighbor) == 0 && !neighbor->isVisited()) 
+    if(!this->nodes.isVisited(neighbor)) 
         this->unvisitedNodes.insert(neighbor);
 }
 
-std::shared_ptr<Node> ConcreteAlgorithm::getClosestAdjacentNode() {
-    std::shared_ptr<Node> currNode = this->houseMap[this->robotCoords];
-    std::vector<std::shared_ptr<Node>> neighbors = currNode->getNeighbors();
+NodeId ConcreteAlgorithm::getClosestAdjacentNode() {
+    PerfScope scope(this->profiler, PerfPhase::ClosestAdjacentNode);
+    NodeId currNode = this->houseMap[this->robotCoords];
 
     int shortestDistance = std::numeric_limits<int>::max();
-    std::shared_ptr<Node> closestNode = nullptr;
+    NodeId closestNode = NodeMap::NONE;
 
     /* Find the neighbor of the current node with the lowest Euclidean distance to dock. */
-    for(int i = 0; i < neighbors.size(); i++) {
-        std::shared_ptr<Node> adjacentNode = neighbors[i];
-        
+    this->nodes.forEachNeighbor(currNode, [&](NodeId adjacentNode) {
         /* Skip visited nodes. */
-        if(adjacentNode->isVisited())
-            continue;
+        if(this->nodes.isVisited(adjacentNode))
+            return;
         
-        if(adjacentNode->getEuclidianDist() < shortestDistance) {
-            shortestDistance = adjacentNode->getEuclidianDist();
+        if(this->nodes.getEuclidianDist(adjacentNode) < shortestDistance) {
+            shortestDistance = this->nodes.getEuclidianDist(adjacentNode);
             closestNode = adjacentNode;
         }
-    }
+    });
     return closestNode;
 }
 
 void ConcreteAlgorithm::setClosestNonAdjacentNodePath() {
-    std::shared_ptr<Node> curr = this->houseMap[this->robotCoords];
-    std::vector<std::shared_ptr<Node>> unreachableNodes;
-
-    /* Maintain the shortest path to an unvisited node. */
-    std::stack<std::shared_ptr<Node>> nextPath;
-    int pathSize = std::numeric_limits<int>::max();
+    PerfScope scope(this->profiler, PerfPhase::ClosestNonAdjacentNodePath);
+    TraceScope span(this->tracer, "setClosestNonAdjacentNodePath", "planner", this->stepCount);
+    NodeId curr = this->houseMap[this->robotCoords];
+
+    /* If the distance to a node is greater than half the max amount of battery, it is impossible to reach. */
+    int radius = this->batteryCap / 2;
+
+    /* Run a single breadth-first wavefront from the current node, bounded by the reachable radius. */
+    std::uint32_t generation = beginSearch();
+    size_t head = 0, tail = 0, levelEnd = 1;
+    int dist = 0;
+    NodeId closest = NodeMap::NONE;
+    size_t reached = 0;
+
+    this->searchQueue[tail++] = curr;
+    this->searchStamp[curr] = generation;
+    this->searchParent[curr] = NodeMap::NONE;
+
+    /* Stop once every unvisited node has been reached, or the radius has been exhausted. */
+    while(head < tail && reached < this->unvisitedNodes.size()) {
+        /* Every node before levelEnd is dist away from the current node. */
+        if(head == levelEnd) {
+            dist++;
+            levelEnd = tail;
+        }
+        NodeId node = this->searchQueue[head++];
 
-    /* Determine the unvisited node to traverse based on proximity to current node. */
-    for(auto& unvisitedNode : this->unvisitedNodes) {
-        auto path = findShortestPath(curr, unvisitedNode);
+        if(this->unvisitedNodes.contains(node)) {
+            /* The first unvisited node reached is the closest one. */
+            if(closest == NodeMap::NONE)
+                closest = node;
+            reached++;
+        }
 
-        /* If the distance to a node is greater than the max amount of battery, it is impossible to reach, remove it */
-        if(path.size() > this->batteryCap / 2) {
-            unreachableNodes.push_back(unvisitedNode);
+        if(dist == radius)
             continue;
-        }
 
-        if(path.size() < pathSize) {
-            nextPath = path;
-            pathSize = path.size();
-        }
+        this->nodes.forEachNeighbor(node, [&](NodeId neighbor) {
+            if(this->searchStamp[neighbor] != generation) {
+                this->searchStamp[neighbor] = generation;
+                this->searchParent[neighbor] = node;
+                this->searchQueue[tail++] = neighbor;
+            }
+        });
+        INSTRUMENT(this->stats.searchQueuePeak = std::max<std::uint64_t>(this->stats.searchQueuePeak, tail - head);)
     }
-    this->pathToNode = nextPath;
+    INSTRUMENT(this->stats.searches++; this->stats.nodesExpanded += head;)
 
-    /* Remove all unreachable nodes from unvisitedNodes list */
-    for(auto& node : unreachableNodes) {
-        this->unvisitedNodes.erase(node);
-    }
+    /* Backtrack from the closest node to the current node. Add each node to the path. */
+    this->pathToNode.clear();
+    for(NodeId pathNode = closest; pathNode != NodeMap::NONE && this->searchParent[pathNode] != NodeMap::NONE; pathNode = this->searchParent[pathNode])
+        this->pathToNode.push_back(pathNode);
+
+    /* Remove all unvisited nodes the wavefront could not reach from unvisitedNodes list. */
+    this->unvisitedNodes.eraseIf([&](NodeId node) { return this->searchStamp[node] != generation; });
 }
 
-Step ConcreteAlgorithm::getDirectionToNode(std::shared_ptr<Node> node) {
+Step ConcreteAlgorithm::getDirectionToNode(NodeId node) {
     /* Given a node that is directly adjacent to the robot, get the direction to that node. */
-    Coordinate goToCoords = node->getCoords();
+    Coordinate goToCoords = this->nodes.getCoords(node);
 
     Step s = Step::Stay;
 
@@ -257,69 +358,93 @@ Step ConcreteAlgorithm::getDirectionToNode(std::shared_ptr<Node> node) {
     /* Update robot's location after movement. */
     this->robotCoords = goToCoords;
 
-    /* Assume always moving away from dock in estimation. */
-    this->distFromDock++;
-
     return s;
 }
 
-std::stack<std::shared_ptr<Node>> ConcreteAlgorithm::findShortestPath(std::shared_ptr<Node> start, std::shared_ptr<Node> end) {
-    /* Assumes start and end exist, and the path stack has been cleared. */
-
-    /* Create map to store the parent of each node for the shortest path. */
-    std::unordered_map<std::shared_ptr<Node>, std::shared_ptr<Node>> parent;
+NodeId ConcreteAlgorithm::addNode(Coordinate coords) {
+    NodeId id = this->nodes.addNode(coords);
+    this->houseMap.insert(coords, id);
 
-    /* Create the map to store whether each node has been visited. */
-    std::unordered_set<std::shared_ptr<Node>> visited;
+    /* Keep the search buffers sized to the map, growing them geometrically along with it. */
+    this->searchStamp.push_back(0);
+    this->searchParent.push_back(NodeMap::NONE);
+    this->searchQueue.push_back(NodeMap::NONE);
+    return id;
+}
 
-    /* Create queue for traversal. */
-    std::queue<std::shared_ptr<Node>> queue;
+std::uint32_t ConcreteAlgorithm::beginSearch() {
+    /* On wraparound, clear all stamps so that no node appears reached by the new generation. */
+    if(++this->searchGeneration == 0) {
+        std::fill(this->searchStamp.begin(), this->searchStamp.end(), 0);
+        this->searchGeneration = 1;
+    }
+    return this->searchGeneration;
+}
 
-    queue.push(start);
-    parent[start] = nullptr;
+void ConcreteAlgorithm::updateDistFromDock(NodeId a, NodeId b) {
+    /* Distances only ever shrink as edges are added. Seed the update from whichever endpoint got closer. */
+    size_t head = 0, tail = 0;
+    int distA = this->nodes.getDistFromDock(a);
+    int distB = this->nodes.getDistFromDock(b);
 
-    while(!queue.empty()) {
-        // Examine next node in queue.
-        std::shared_ptr<Node> node = queue.front();
-        queue.pop();
-        visited.insert(node);
+    if(distA != NodeMap::UNREACHED && distA + 1 < distB) {
+        this->nodes.setDistFromDock(b, distA + 1);
+        this->searchQueue[tail++] = b;
+    }
+    else if(distB != NodeMap::UNREACHED && distB + 1 < distA) {
+        this->nodes.setDistFromDock(a, distB + 1);
+        this->searchQueue[tail++] = a;
+    }
 
-        // Reached target.
-        if(node == end) 
-            break;
-        
-        // If a neighbor of the node is not visited, push it into the queue. Set the neighbor's parent to the node.
-        for(auto& neighbor : node->getNeighbors()) {
-            if(visited.count(neighbor) == 0) {
-                queue.push(neighbor);
-                parent[neighbor] = node;
+    /* Propagate the shorter distance outwards until no neighbor improves. Nodes are improved in order of
+       distance, so each node is queued at most once. */
+    while(head < tail) {
+        NodeId node = this->searchQueue[head++];
+        int dist = this->nodes.getDistFromDock(node);
+        INSTRUMENT(this->stats.distanceUpdates++;)
+
+        this->nodes.forEachNeighbor(node, [&](NodeId neighbor) {
+            if(dist + 1 < this->nodes.getDistFromDock(neighbor)) {
+                this->nodes.setDistFromDock(neighbor, dist + 1);
+                this->searchQueue[tail++] = neighbor;
             }
-        }
+        });
     }
+}
 
-    std::stack<std::shared_ptr<Node>> path;
-
-    // No possible path exists.
-    if(visited.count(end) == 0)
-        return path;
-
-    // Backtrack from end to start. Add each node to stack.
-    std::shared_ptr<Node> pathNode = end;
-    while(parent[pathNode] != nullptr) {
-        path.push(pathNode);
-        pathNode = parent[pathNode];
+void ConcreteAlgorithm::findPathToDock(NodeId start, std::vector<NodeId>& path) {
+    PerfScope scope(this->profiler, PerfPhase::PathToDock);
+    TraceScope span(this->tracer, "findPathToDock", "planner", this->stepCount);
+    /* Walk down the distance field from start to the dock, one node closer each step. Fill the path from
+       the back so that the first move ends up on top. */
+    NodeId node = start;
+    int dist = this->nodes.getDistFromDock(start);
+    path.resize(dist);
+
+    while(dist > 0) {
+        NodeId next = node;
+        this->nodes.forEachNeighbor(node, [&](NodeId neighbor) {
+            if(next == node && this->nodes.getDistFromDock(neighbor) == dist - 1)
+                next = neighbor;
+        });
+        node = next;
+        path[--dist] = node;
     }
+}
 
-    return path;
+#ifdef ROBOT_INSTRUMENT
+const AlgorithmStats& ConcreteAlgorithm::getStats() const {
+    return this->stats;
 }
+#endif
 
 Step ConcreteAlgorithm::returnToDock() {
     /* Sanity check. */
     if(this->pathToDock.empty()) 
         return Step::Stay;
 
-    auto node = this->pathToDock.top();
-    this->pathToDock.pop();
+    NodeId node = this->pathToDock.back();
+    this->pathToDock.pop_back();
     return getDirectionToNode(node);
 }
 
@@ -328,8 +453,8 @@ Step ConcreteAlgorithm::moveToNode() {
     if(this->pathToNode.empty()) 
         return Step::Stay;
 
-    auto node = this->pathToNode.top();
-    this->pathToNode.pop();
+    NodeId node = this->pathToNode.back();
+    this->pathToNode.pop_back();
     return getDirectionToNode(node);
 }
 
@@ -1,9 +1,5 @@
 #include "concrete_battery_meter.h"
 
-size_t ConcreteBatteryMeter::getBatteryState() const {
-    return batteryState;
-}
-
 void ConcreteBatteryMeter::setBatteryState(size_t batteryState) {
     this->batteryState = batteryState;
 }
\ No newline at end of file
@@ -1,9 +1,5 @@
 #include "concrete_dirt_sensor.h"
 
-int ConcreteDirtSensor::dirtLevel() const {
-    return this->dirt;
-}
-
 void ConcreteDirtSensor::setDirtLevel(int dirtLevel) {
     this->dirt = dirtLevel;
 }
\ No newline at end of file
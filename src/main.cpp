@@ -1,26 +1,182 @@
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
+#include "batch_runner.h"
 #include "simulation.h"
+#include "sweep_runner.h"
+
+#define USAGE "USAGE: ./robot <houseFilePath> [--stats <statsFilePath>] [--perf <perfFilePath>] [--trace <traceFilePath>] [--step-trace <stepTraceFilePath>] | ./robot --batch <houseFileOrDir>... [--out <outputDir>] [--headless]" \
+              " | ./robot --sweep <houseFilePath> [--steps <list>] [--battery <list>] [--out <outputDir>] [--headless]," \
+              " where <list> is comma separated values N or ranges first:last[:stride]"
+
+int runBatch(int argc, char** argv) {
+    /* Separate the options from the inputs. */
+    std::string outputDir = ".";
+    std::vector<std::string> inputs;
+    bool headless = false;
+    for(int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if(arg == "--out" && i + 1 < argc)
+            outputDir = argv[++i];
+        else if(arg == "--headless")
+            headless = true;
+        else
+            inputs.push_back(arg);
+    }
+    if(inputs.empty()) {
+        std::cerr << "Too few arguments. " << USAGE << std::endl;
+        return 1;
+    }
+
+    BatchRunner b(outputDir);
+    b.setHeadless(headless);
+    for(const std::string& input : inputs) {
+        if(!b.addInput(input)) {
+            std::cerr << "Unable to find house file or directory: " << input << std::endl;
+            return 1;
+        }
+    }
+
+    if(!b.run()) {
+        std::cerr << "Some houses could not be simulated due to I/O error or invalid input, see " << SUMMARY_FILE << "." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runSweep(int argc, char** argv) {
+    /* Separate the parameter lists and options from the house file. */
+    std::string outputDir = ".";
+    std::string houseFilePath;
+    std::vector<std::string> stepLists, batteryLists;
+    bool headless = false;
+    for(int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if(arg == "--out" && i + 1 < argc)
+            outputDir = argv[++i];
+        else if(arg == "--headless")
+            headless = true;
+        else if(arg == "--steps" && i + 1 < argc)
+            stepLists.push_back(argv[++i]);
+        else if(arg == "--battery" && i + 1 < argc)
+            batteryLists.push_back(argv[++i]);
+        else if(houseFilePath.empty())
+            houseFilePath = arg;
+        else {
+            std::cerr << "Unexpected argument: " << arg << ". " << USAGE << std::endl;
+            return 1;
+        }
+    }
+    if(houseFilePath.empty()) {
+        std::cerr << "Too few arguments. " << USAGE << std::endl;
+        return 1;
+    }
+
+    SweepRunner sr(outputDir);
+    sr.setHeadless(headless);
+    for(const std::string& list : stepLists) {
+        if(!sr.addSteps(list)) {
+            std::cerr << "Invalid MaxSteps list: " << list << std::endl;
+            return 1;
+        }
+    }
+    for(const std::string& list : batteryLists) {
+        if(!sr.addBattery(list)) {
+            std::cerr << "Invalid MaxBattery list: " << list << std::endl;
+            return 1;
+        }
+    }
+    if(!sr.readHouseFile(houseFilePath)) {
+        std::cerr << "Unable to read house file due to I/O error or invalid input." << std::endl;
+        return 1;
+    }
+
+    if(!sr.run()) {
+        std::cerr << "Some runs could not be written due to I/O error, see " << SWEEP_FILE << "." << std::endl;
+        return 1;
+    }
+    return 0;
+}
 
 int main(int argc, char** argv) {
     if(argc < 2) {
-        std::cerr << "Too few arguments. USAGE: ./robot <houseFilePath>" << std::endl;
+        std::cerr << "Too few arguments. " << USAGE << std::endl;
         return 1;
     }
+    if(std::string(argv[1]) == "--batch")
+        return runBatch(argc, argv);
+    if(std::string(argv[1]) == "--sweep")
+        return runSweep(argc, argv);
+
     std::string houseFilePath = argv[1];
-    
-    Simulation s;
+
+    /* Optional report files follow the house file as flag/path pairs. */
+    std::string statsFilePath, perfFilePath, traceFilePath, stepTraceFilePath;
+    for(int i = 2; i + 1 < argc; i += 2) {
+        if(std::string(argv[i]) == "--stats")
+            statsFilePath = argv[i + 1];
+        else if(std::string(argv[i]) == "--perf")
+            perfFilePath = argv[i + 1];
+        else if(std::string(argv[i]) == "--trace")
+            traceFilePath = argv[i + 1];
+        else if(std::string(argv[i]) == "--step-trace")
+            stepTraceFilePath = argv[i + 1];
+    }
+
+    /* Counters are only collected by instrumented builds. */
+#ifndef ROBOT_INSTRUMENT
+    if(!statsFilePath.empty()) {
+        std::cerr << "Counters are unavailable, rebuild with -DROBOT_INSTRUMENT=ON to collect them." << std::endl;
+        return 1;
+    }
+#endif
+
+    /* Hardware counters are attributed to each phase of the mission. */
+    PerfProfiler profiler;
+    if(!perfFilePath.empty() && !profiler.open()) {
+        std::cerr << "Unable to open performance counters, check /proc/sys/kernel/perf_event_paranoid." << std::endl;
+        return 1;
+    }
+
+    /* Timeline of the mission, viewable in chrome://tracing or Perfetto. */
+    TraceWriter tracer;
+    StepTraceWriter stepTrace(stepTraceFilePath);
+
+    Simulation<> s;
+    s.setProfiler(perfFilePath.empty() ? nullptr : &profiler);
+    s.setTracer(traceFilePath.empty() ? nullptr : &tracer);
+    s.setStepTrace(stepTraceFilePath.empty() ? nullptr : &stepTrace);
     if(!s.readHouseFile(houseFilePath)) {
         std::cerr << "Unable to read house file due to I/O error or invalid input." << std::endl;
         return 1;
     }
 
-    ConcreteAlgorithm a;
+    ConcreteSpecializedAlgorithm a;
     s.setAlgorithm(a);
     if(!s.run()) {
         std::cerr << "Unable to write to output file due to I/O error." << std::endl;
         return 1;
     }
 
+#ifdef ROBOT_INSTRUMENT
+    if(!statsFilePath.empty() && !s.writeStats(statsFilePath)) {
+        std::cerr << "Unable to write to stats file due to I/O error." << std::endl;
+        return 1;
+    }
+#endif
+
+    if(!perfFilePath.empty()) {
+        std::ofstream f = std::ofstream(perfFilePath);
+        profiler.writeJson(f);
+        if(f.fail()) {
+            std::cerr << "Unable to write to perf file due to I/O error." << std::endl;
+            return 1;
+        }
+    }
+    if(!traceFilePath.empty() && !tracer.write(traceFilePath)) {
+        std::cerr << "Unable to write to trace file due to I/O error." << std::endl;
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}
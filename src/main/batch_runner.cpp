@@ -0,0 +1,101 @@
+#include "batch_runner.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+#include "csv.h"
+
+bool BatchRunner::addInput(const std::string path) {
+    std::error_code ec;
+
+    if(std::filesystem::is_regular_file(path, ec)) {
+        this->houseFiles.push_back(path);
+        return true;
+    }
+    if(!std::filesystem::is_directory(path, ec))
+        return false;
+
+    /* Sort directory entries so batches are reproducible. */
+    std::vector<std::string> entries;
+    for(const auto& entry : std::filesystem::directory_iterator(path, ec)) {
+        if(entry.is_regular_file(ec))
+            entries.push_back(entry.path().string());
+    }
+    std::sort(entries.begin(), entries.end());
+    this->houseFiles.insert(this->houseFiles.end(), entries.begin(), entries.end());
+    return !ec;
+}
+
+void BatchRunner::setHeadless(const bool headless) {
+    this->headless = headless;
+}
+
+bool BatchRunner::run() {
+    std::error_code ec;
+    std::filesystem::create_directories(this->outputDir, ec);
+    if(ec)
+        return false;
+
+    /* Each task only writes its own slot and its own files, so results need no locking. */
+    assignOutputFiles();
+    std::vector<BatchResult> results(this->houseFiles.size());
+    {
+        ThreadPool pool;
+        for(size_t i = 0; i < this->houseFiles.size(); i++) {
+            pool.submit([this, &results, i] {
+                results[i] = simulate(this->houseFiles[i], this->outputFiles[i]);
+            });
+        }
+        pool.wait();
+    }
+
+    bool success = writeSummary(results);
+    for(const BatchResult& result : results)
+        success = success && result.success;
+    return success;
+}
+
+void BatchRunner::assignOutputFiles() {
+    /* Houses such as a/house.txt and b/house.txt, or house.txt and house.dat, share a stem. */
+    std::unordered_set<std::string> taken;
+    this->outputFiles.clear();
+    for(const std::string& houseFile : this->houseFiles) {
+        std::string stem = std::filesystem::path(houseFile).stem().string();
+        std::string name = stem;
+        for(int n = 2; !taken.insert(name).second; n++)
+            name = stem + "_" + std::to_string(n);
+        this->outputFiles.push_back((std::filesystem::path(this->outputDir) / (name + "_output.txt")).string());
+    }
+}
+
+BatchRunner::BatchResult BatchRunner::simulate(const std::string houseFilePath, const std::string outputFilePath) const {
+    Simulation<> s(outputFilePath);
+    if(!s.readHouseFile(houseFilePath))
+        return BatchResult{false, MissionSummary()};
+
+    ConcreteSpecializedAlgorithm a;
+    s.setHeadless(this->headless);
+    s.setAlgorithm(a);
+    if(!s.run())
+        return BatchResult{false, MissionSummary()};
+
+    return BatchResult{true, s.getSummary()};
+}
+
+bool BatchRunner::writeSummary(const std::vector<BatchResult>& results) const {
+    std::ofstream f = std::ofstream(std::filesystem::path(this->outputDir) / SUMMARY_FILE);
+    if(f.fail())
+        return false;
+
+    /* Houses that could not be simulated are reported with an ERROR status and no counts. */
+    f << "House,NumSteps,DirtLeft,Status" << std::endl;
+    for(size_t i = 0; i < results.size(); i++) {
+        f << csvField(this->houseFiles[i]) << ",";
+        if(results[i].success)
+            f << results[i].summary.numSteps << "," << results[i].summary.dirtLeft << "," << results[i].summary.status << std::endl;
+        else
+            f << ",,ERROR" << std::endl;
+    }
+    return f.good();
+}
@@ -1,39 +1,83 @@
 #include "house.h"
 
-bool House::houseSetup(const std::string infilePath) {
-    FileReader fr = FileReader(infilePath); 
+#include <algorithm>
 
-    /* I/O error or Line 4/5/6+ invalid. */
-    if(!fr.readSpaces(this->spaces, this->dirtLevel))
-        return false;
-    
-    return true;
+void House::houseSetup(const HouseLayout& layout) {
+    std::shared_ptr<Grid> g = std::make_shared<Grid>();
+    g->rows = layout.rows;
+    g->cols = layout.cols;
+    g->dockRow = layout.dockRow;
+    g->dockCol = layout.dockCol;
+    g->cells.assign(layout.cells.size(), WALL_CELL);
+    g->tileCols = (g->cols + TILE_SIZE - 1) / TILE_SIZE;
+    g->tileDirt.assign(long(g->tileCols) * ((g->rows + TILE_SIZE - 1) / TILE_SIZE), 0);
+    g->remainingDirt = 0;
+
+    /* Store the dirt level of every non-wall cell along with the walls surrounding it, computed once here. */
+    for(int row = 0; row < g->rows; row++) {
+        for(int col = 0; col < g->cols; col++) {
+            signed char c = layout.at(row, col);
+            if(c == HouseLayout::WALL)
+                continue;
+
+            unsigned char walls = 0;
+            if(row == 0 || layout.at(row - 1, col) == HouseLayout::WALL)
+                walls |= 1 << static_cast<int>(Direction::North);
+            if(col == g->cols - 1 || layout.at(row, col + 1) == HouseLayout::WALL)
+                walls |= 1 << static_cast<int>(Direction::East);
+            if(row == g->rows - 1 || layout.at(row + 1, col) == HouseLayout::WALL)
+                walls |= 1 << static_cast<int>(Direction::South);
+            if(col == 0 || layout.at(row, col - 1) == HouseLayout::WALL)
+                walls |= 1 << static_cast<int>(Direction::West);
+
+            g->cells[long(row) * g->cols + col] = (walls << WALL_SHIFT) | c;
+            g->tileDirt[long(row / TILE_SIZE) * g->tileCols + col / TILE_SIZE] += c;
+            g->remainingDirt += c;
+        }
+    }
+
+    /* Start from the initial dirt, with no tiles copied yet. */
+    this->grid = g;
+    this->tileCells.assign(g->tileDirt.size(), std::vector<unsigned char>());
+    this->tileDirt = g->tileDirt;
+    this->remainingDirt = g->remainingDirt;
 }
 
 bool House::isValidSpace(const Coordinate space) const {
-    return this->spaces.find(space) != this->spaces.end();
+    int row, col;
+    return locate(space, row, col);
+}
+
+unsigned char House::getWalls(const Coordinate space) const {
+    int row, col;
+
+    /* A space outside the house or inside a wall is enclosed on all sides. Walls never change, so the shared grid is current. */
+    if(!locate(space, row, col))
+        return ALL_WALLS;
+    return this->grid->cells[long(row) * this->grid->cols + col] >> WALL_SHIFT;
 }
 
 int House::getDirt(const Coordinate space) const {
-    std::unordered_map<Coordinate, int>::const_iterator it = this->dirtLevel.find(space);
+    int row, col;
 
     /* If space exists. */
-    if(this->dirtLevel.find(space) != this->dirtLevel.end()) 
-    {
-        return it->second;
-    }
-    return 0;
+    if(!locate(space, row, col))
+        return 0;
+
+    /* Cleaned tiles are read from the private copy, others from the shared grid. */
+    const std::vector<unsigned char>& tile = this->tileCells[tileIndex(row, col)];
+    if(!tile.empty())
+        return tile[tileOffset(row, col)] & DIRT_MASK;
+    return this->grid->cells[long(row) * this->grid->cols + col] & DIRT_MASK;
 }
 
 int House::getRemainingDirt() const {
-    int sum = 0;
-    std::unordered_map<Coordinate, int>::const_iterator it = this->dirtLevel.begin();
+    return this->remainingDirt;
+}
 
-    /* Iterate through spaces. */
-    for(it; it != this->dirtLevel.end(); it++) {
-        sum += it->second;
-    }
-    return sum;
+int House::getTileDirt(const Coordinate space) const {
+    int row, col;
+    return locate(space, row, col) ? this->tileDirt[tileIndex(row, col)] : 0;
 }
 
 bool House::isHouseClean() const {   
@@ -41,10 +85,39 @@ bool House::isHouseClean() const {
 }
 
 void House::cleanSpace(const Coordinate space) {
-    std::unordered_map<Coordinate, int>::iterator it = this->dirtLevel.find(space);
+    cleanSpace(space, 1);
+}
+
+void House::cleanSpace(const Coordinate space, const int times) {
+    int row, col;
 
     /* If space exists and dirt level of space > 0. */
-    if(it != this->dirtLevel.end() && it->second > 0) {
-        it->second -= 1;
+    if(!locate(space, row, col) || getDirt(space) == 0 || times <= 0)
+        return;
+    int cleaned = std::min(times, getDirt(space));
+
+    /* Take a private copy of the tile on first write. */
+    long t = tileIndex(row, col);
+    std::vector<unsigned char>& tile = this->tileCells[t];
+    if(tile.empty()) {
+        tile.assign(TILE_SIZE * TILE_SIZE, WALL_CELL);
+        int rowStart = row / TILE_SIZE * TILE_SIZE, colStart = col / TILE_SIZE * TILE_SIZE;
+        for(int r = rowStart; r < rowStart + TILE_SIZE && r < this->grid->rows; r++) {
+            for(int c = colStart; c < colStart + TILE_SIZE && c < this->grid->cols; c++)
+                tile[tileOffset(r, c)] = this->grid->cells[long(r) * this->grid->cols + c];
+        }
     }
-}
\ No newline at end of file
+
+    tile[tileOffset(row, col)] -= cleaned;
+    this->tileDirt[t] -= cleaned;
+    this->remainingDirt -= cleaned;
+}
+
+bool House::locate(const Coordinate space, int& row, int& col) const {
+    row = this->grid->dockRow - space.y;
+    col = space.x + this->grid->dockCol;
+
+    if(row < 0 || row >= this->grid->rows || col < 0 || col >= this->grid->cols)
+        return false;
+    return this->grid->cells[long(row) * this->grid->cols + col] != WALL_CELL;
+}
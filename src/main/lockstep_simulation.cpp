@@ -0,0 +1,85 @@
+#include "lockstep_simulation.h"
+
+std::size_t LockstepSimulation::addMission(const House& house, const int maxSteps, const int maxBattery, const std::string outputFilePath) {
+    std::unique_ptr<Mission> m = std::make_unique<Mission>(outputFilePath);
+    m->h = house;
+
+    m->algo.setMaxSteps(maxSteps);
+    m->algo.setBatteryMeter(m->bm);
+    m->algo.setDirtSensor(m->ds);
+    m->algo.setWallsSensor(m->ws);
+
+    this->missions.push_back(std::move(m));
+    return this->robots.addRobot(maxSteps, maxBattery);
+}
+
+std::size_t LockstepSimulation::size() const {
+    return this->missions.size();
+}
+
+bool LockstepSimulation::run() {
+    std::vector<std::size_t> running;
+    std::vector<Step> nextSteps(this->missions.size());
+    for(std::size_t i = 0; i < this->missions.size(); i++) {
+        if(!this->robots.budgetExceeded(i))
+            running.push_back(i);
+    }
+
+    /* Iterate until every mission has finished or reached maxSteps. */
+    while(!running.empty()) {
+        for(std::size_t i : running) {
+            nextSteps[i] = queryAlgorithm(i);
+            if(!this->headless)
+                this->missions[i]->fw.recordStep(nextSteps[i]);
+            this->robots.stageStep(i, nextSteps[i]);
+        }
+        this->robots.move();
+
+        /* Clean spots stayed on, and drop finished missions. */
+        std::size_t kept = 0;
+        for(std::size_t i : running) {
+            if(nextSteps[i] == Step::Finish) {
+                this->missions[i]->finished = true;
+                continue;
+            }
+            if(nextSteps[i] == Step::Stay)
+                this->missions[i]->h.cleanSpace(this->robots.getLoc(i));
+            if(!this->robots.budgetExceeded(i))
+                running[kept++] = i;
+        }
+        running.resize(kept);
+    }
+
+    bool success = true;
+    for(std::size_t i = 0; i < this->missions.size(); i++) {
+        Mission& m = *this->missions[i];
+        m.written = this->headless || m.fw.recordResults(this->robots.getStepCount(i), m.h.getRemainingDirt(), this->robots.getBatteryLeft(i));
+        success = success && m.written;
+    }
+    return success;
+}
+
+bool LockstepSimulation::outputWritten(const std::size_t mission) const {
+    return this->missions[mission]->written;
+}
+
+MissionSummary LockstepSimulation::getSummary(const std::size_t mission) const {
+    const Mission& m = *this->missions[mission];
+    int batteryLeft = this->robots.getBatteryLeft(mission);
+    return MissionSummary{this->robots.getStepCount(mission), m.h.getRemainingDirt(), FileWriter::getRobotStatus(m.finished, batteryLeft)};
+}
+
+Step LockstepSimulation::queryAlgorithm(const std::size_t mission) {
+    Mission& m = *this->missions[mission];
+    Coordinate currLoc = this->robots.getLoc(mission);
+    unsigned char walls = m.h.getWalls(currLoc);
+
+    m.bm.setBatteryState(this->robots.getBatteryLeft(mission));
+    m.ds.setDirtLevel(m.h.getDirt(currLoc));
+    m.ws.setWall(walls & (1 << static_cast<int>(Direction::North)), Direction::North);
+    m.ws.setWall(walls & (1 << static_cast<int>(Direction::West)), Direction::West);
+    m.ws.setWall(walls & (1 << static_cast<int>(Direction::South)), Direction::South);
+    m.ws.setWall(walls & (1 << static_cast<int>(Direction::East)), Direction::East);
+
+    return m.algo.nextStep();
+}
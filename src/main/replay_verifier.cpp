@@ -0,0 +1,256 @@
+#include "replay_verifier.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "file_reader.h"
+#include "file_writer.h"
+#include "step_trace.h"
+
+namespace {
+    /* Bytes of an output file's steps read at a time, so memory stays constant however long the mission. */
+    constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+    /* Score penalties of the assignment's scoring rule, per unit of dirt left, for a dead battery, for finishing
+     * away from the dock, and for otherwise ending away from the dock. */
+    constexpr std::uint64_t DIRT_PENALTY = 300;
+    constexpr std::uint64_t DEAD_PENALTY = 2000;
+    constexpr std::uint64_t FINISHED_OFF_DOCK_PENALTY = 3000;
+    constexpr std::uint64_t OFF_DOCK_PENALTY = 1000;
+
+    /* Parses "<key> = <value>" into its value. */
+    bool parseField(const std::string& line, const std::string& key, std::string& value) {
+        std::string prefix = key + " = ";
+        if(line.compare(0, prefix.size(), prefix) != 0)
+            return false;
+        value = line.substr(prefix.size());
+        if(!value.empty() && value.back() == '\r')
+            value.pop_back();
+        return !value.empty();
+    }
+
+    /* Parses "<key> = <number>" into its number. */
+    template <typename T>
+    bool parseNumberField(const std::string& line, const std::string& key, T& number) {
+        std::string value;
+        if(!parseField(line, key, value))
+            return false;
+        auto [ptr, err] = std::from_chars(value.data(), value.data() + value.size(), number);
+        return err == std::errc() && ptr == value.data() + value.size();
+    }
+
+    /* Converts a step character of an output file into its step. */
+    bool toStep(const char c, Step& s) {
+        switch(c) {
+            case 'N': s = Step::North; return true;
+            case 'E': s = Step::East; return true;
+            case 'S': s = Step::South; return true;
+            case 'W': s = Step::West; return true;
+            case 's': s = Step::Stay; return true;
+            case 'F': s = Step::Finish; return true;
+            default: return false;
+        }
+    }
+}
+
+bool ReplayVerifier::readHouseFile(const std::string houseFilePath) {
+    FileReader fr = FileReader(houseFilePath);
+    HouseLayout layout;
+    if(!fr.readHouse(layout))
+        return false;
+
+    this->house.houseSetup(layout);
+    this->maxSteps = layout.maxSteps;
+    this->maxBattery = layout.maxBattery;
+    return true;
+}
+
+bool ReplayVerifier::verify(const std::string stepsFilePath) {
+    reset();
+
+    std::ifstream in = std::ifstream(stepsFilePath, std::ios::binary);
+    if(in.fail())
+        return fail("Unable to read " + stepsFilePath, 0);
+
+    /* Step traces start with their magic, output files with their summary. */
+    char magic[sizeof(STEP_TRACE_MAGIC)] = {};
+    in.read(magic, sizeof(magic));
+    bool trace = in.gcount() == sizeof(magic) && std::memcmp(magic, STEP_TRACE_MAGIC, sizeof(magic)) == 0;
+    in.clear();
+    in.seekg(0);
+
+    std::uint64_t numSteps = 0;
+    int dirtLeft = 0;
+    std::string status;
+    bool replayed = trace ? replayTrace(stepsFilePath, numSteps, dirtLeft, status) : replayOutput(in, numSteps, dirtLeft, status);
+
+    /* Summarize whatever was replayed, even up to a violation. */
+    this->report.dirtLeft = this->h.getRemainingDirt();
+    this->report.status = FileWriter::getRobotStatus(this->finished, static_cast<int>(this->batteryLeft));
+    this->report.onDock = this->loc.x == 0 && this->loc.y == 0;
+    this->report.score = score();
+    if(!replayed)
+        return false;
+
+    if(numSteps != this->report.numSteps)
+        return fail("NumSteps reported as " + std::to_string(numSteps) + " but replayed as " + std::to_string(this->report.numSteps), 0);
+    if(dirtLeft != this->report.dirtLeft)
+        return fail("DirtLeft reported as " + std::to_string(dirtLeft) + " but replayed as " + std::to_string(this->report.dirtLeft), 0);
+    if(status != this->report.status)
+        return fail("Status reported as " + status + " but replayed as " + this->report.status, 0);
+
+    this->report.valid = true;
+    return true;
+}
+
+const ReplayReport& ReplayVerifier::getReport() const {
+    return this->report;
+}
+
+std::uint64_t ReplayVerifier::score() const {
+    /* Missions that die or finish away from the dock are charged the whole budget, as if they had used it all. */
+    std::uint64_t dirt = DIRT_PENALTY * static_cast<std::uint64_t>(this->report.dirtLeft);
+    if(this->report.status == "DEAD")
+        return static_cast<std::uint64_t>(this->maxSteps) + dirt + DEAD_PENALTY;
+    if(this->report.status == "FINISHED" && !this->report.onDock)
+        return static_cast<std::uint64_t>(this->maxSteps) + dirt + FINISHED_OFF_DOCK_PENALTY;
+    return this->report.numSteps + dirt + (this->report.onDock ? 0 : OFF_DOCK_PENALTY);
+}
+
+void ReplayVerifier::reset() {
+    this->h = this->house;
+    this->loc = Coordinate(0, 0);
+    this->batteryLeft = this->maxBattery;
+    this->finished = false;
+    this->report = ReplayReport{false, "", 0, 0, 0, "", true, 0, 0, 0, 0, 0};
+}
+
+bool ReplayVerifier::replayOutput(std::istream& in, std::uint64_t& numSteps, int& dirtLeft, std::string& status) {
+    std::string line;
+    if(!std::getline(in, line) || !parseNumberField(line, "NumSteps", numSteps))
+        return fail("Expected NumSteps = <n> on line 1", 0);
+    if(!std::getline(in, line) || !parseNumberField(line, "DirtLeft", dirtLeft))
+        return fail("Expected DirtLeft = <n> on line 2", 0);
+    if(!std::getline(in, line) || !parseField(line, "Status", status))
+        return fail("Expected Status = <status> on line 3", 0);
+    if(!std::getline(in, line) || (line != "Steps:" && line != "Steps:\r"))
+        return fail("Expected Steps: on line 4", 0);
+
+    /* Split each chunk into runs of identical characters. Runs cut by a chunk boundary replay the same in parts. */
+    std::vector<char> chunk(CHUNK_SIZE);
+    while(in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+        const char* p = chunk.data();
+        const char* end = p + in.gcount();
+        while(p < end) {
+            const char* runEnd = p + 1;
+            while(runEnd < end && *runEnd == *p)
+                runEnd++;
+
+            Step s;
+            if(toStep(*p, s)) {
+                if(!replay(s, runEnd - p))
+                    return false;
+            }
+            else if(*p != '\n' && *p != '\r')
+                return fail(std::string("Unknown step ") + *p, this->report.numSteps + 1);
+            p = runEnd;
+        }
+    }
+    return true;
+}
+
+bool ReplayVerifier::replayTrace(const std::string stepsFilePath, std::uint64_t& numSteps, int& dirtLeft, std::string& status) {
+    StepTraceReader reader(stepsFilePath);
+    if(!reader.open())
+        return fail("Unable to read step trace due to I/O error or invalid input", 0);
+
+    const StepTraceHeader& header = reader.getHeader();
+    if(header.maxSteps != this->maxSteps || header.maxBattery != this->maxBattery)
+        return fail("Step trace was recorded with MaxSteps = " + std::to_string(header.maxSteps) + " and MaxBattery = " +
+                    std::to_string(header.maxBattery) + " rather than those of the house file", 0);
+    numSteps = header.numSteps;
+    dirtLeft = header.dirtLeft;
+    status = header.status;
+
+    Step s;
+    std::uint64_t length;
+    while(reader.nextRun(s, length)) {
+        if(!replay(s, length))
+            return false;
+    }
+    if(this->report.numSteps != header.numSteps)
+        return fail("Step trace is corrupt", this->report.numSteps + 1);
+    return true;
+}
+
+bool ReplayVerifier::replay(const Step s, const std::uint64_t length) {
+    std::uint64_t first = this->report.numSteps + 1;
+    if(this->finished)
+        return fail("Step after Finish", first);
+    if(this->report.numSteps + length > static_cast<std::uint64_t>(this->maxSteps))
+        return fail("Step beyond MaxSteps", static_cast<std::uint64_t>(this->maxSteps) + 1);
+
+    /* The step that reaches the budget is recorded, but the robot no longer moves or uses battery. */
+    std::uint64_t active = length;
+    if(this->report.numSteps + length == static_cast<std::uint64_t>(this->maxSteps))
+        active--;
+    this->report.numSteps += length;
+
+    long chargeRate = this->maxBattery / 20;
+    if(s == Step::Finish) {
+        if(length > 1)
+            return fail("Step after Finish", first + 1);
+        this->finished = true;
+        if(this->loc.x != 0 || this->loc.y != 0)
+            return fail("Finished away from the charging dock", first);
+        return true;
+    }
+
+    /* A run of stays cleans its space at most down to 0, and charges or drains the battery linearly. */
+    if(s == Step::Stay) {
+        int cleaned = static_cast<int>(std::min<std::uint64_t>(length, this->h.getDirt(this->loc)));
+        for(int i = 0; i < cleaned; i++)
+            this->h.cleanSpace(this->loc);
+        this->report.dirtCleaned += cleaned;
+
+        if(this->loc.x == 0 && this->loc.y == 0) {
+            this->report.chargingSteps += length;
+            this->batteryLeft = static_cast<long>(std::min<std::uint64_t>(this->batteryLeft + active * chargeRate, this->maxBattery));
+        }
+        else {
+            this->report.cleaningSteps += length;
+            if(active > static_cast<std::uint64_t>(this->batteryLeft))
+                return fail("Battery below 0", first + this->batteryLeft);
+            this->batteryLeft -= active;
+        }
+        return true;
+    }
+
+    /* A run of moves crosses one space per step, each checked for a wall. */
+    this->report.moveSteps += length;
+    int direction = static_cast<int>(s);
+    int dx = s == Step::East ? 1 : s == Step::West ? -1 : 0;
+    int dy = s == Step::North ? 1 : s == Step::South ? -1 : 0;
+    for(std::uint64_t i = 0; i < active; i++) {
+        if(this->h.getWalls(this->loc) & (1 << direction))
+            return fail("Entered a wall", first + i);
+        this->loc.x += dx;
+        this->loc.y += dy;
+
+        this->batteryLeft--;
+        if(this->loc.x == 0 && this->loc.y == 0)
+            this->batteryLeft = std::min<long>(this->batteryLeft + chargeRate, this->maxBattery);
+        if(this->batteryLeft < 0)
+            return fail("Battery below 0", first + i);
+    }
+    return true;
+}
+
+bool ReplayVerifier::fail(const std::string error, const std::uint64_t step) {
+    this->report.valid = false;
+    this->report.error = error;
+    this->report.errorStep = step;
+    return false;
+}
@@ -1,26 +1,24 @@
 #include "robot.h"
 
-bool Robot::robotSetup(const std::string infilePath) {
-    FileReader fr = FileReader(infilePath);
-    
-    /* I/O error or Line 3 invalid. */
-    int temp = fr.readMaxBattery();
-    if (temp == -1)
-        return false;
-    this->batteryCap = this->batteryLeft = temp;
-    
-    /* I/O error or Line 2 invalid. */
-    temp = fr.readMaxSteps();
-    if (temp == -1)
-        return false;
-    this->missionBudget = temp;
-
-    return true;
+#include <algorithm>
+
+void Robot::robotSetup(const HouseLayout& layout) {
+    robotSetup(layout.maxSteps, layout.maxBattery);
+}
+
+void Robot::robotSetup(const int maxSteps, const int maxBattery) {
+    this->batteryCap = this->batteryLeft = maxBattery;
+    this->missionBudget = maxSteps;
 }
 
 int Robot::getMissionBudget() const {
     return this->missionBudget;
 }
+
+int Robot::getBatteryCap() const {
+    return this->batteryCap;
+}
+
 int Robot::getStepCount() const {
     return this->stepCount;
 }
@@ -70,3 +68,20 @@ void Robot::move(const Step s) {
         this->batteryLeft = chargedBattery <= this->batteryCap ? chargedBattery : this->batteryCap;
     }   
 }
+
+void Robot::stay(const int times) {
+    if(times <= 0)
+        return;
+
+    /* As with move(), a stay on an empty battery, or from the one reaching the budget onwards, has no effect. */
+    int effective = this->batteryLeft < 0 ? 0 : std::max(0, std::min(times, this->missionBudget - 1 - this->stepCount));
+    this->stepCount += times;
+
+    /* Staying on dock charges each time, staying elsewhere costs battery each time until it runs out. */
+    if(onChargingDock()) {
+        long long chargedBattery = this->batteryLeft + static_cast<long long>(effective) * (this->batteryCap / 20);
+        this->batteryLeft = static_cast<int>(std::min<long long>(chargedBattery, this->batteryCap));
+    }
+    else
+        this->batteryLeft -= std::min(effective, this->batteryLeft + 1);
+}
@@ -0,0 +1,119 @@
+#include "robot_lanes.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+std::size_t RobotLanes::addRobot(const int maxSteps, const int maxBattery) {
+    std::size_t lane = this->count++;
+
+    /* Grow every array by a whole group of inert lanes at once. */
+    if(lane == this->stepCount.size()) {
+        for(std::vector<std::int32_t>* v : {&this->batteryCap, &this->chargeRate, &this->missionBudget,
+                                            &this->stepCount, &this->batteryLeft, &this->x, &this->y,
+                                            &this->staged, &this->dx, &this->dy, &this->stay, &this->finish})
+            v->resize(v->size() + LANE_WIDTH, 0);
+    }
+
+    this->batteryCap[lane] = this->batteryLeft[lane] = maxBattery;
+    this->chargeRate[lane] = maxBattery / 20;
+    this->missionBudget[lane] = maxSteps;
+    return lane;
+}
+
+std::size_t RobotLanes::size() const {
+    return this->count;
+}
+
+int RobotLanes::getMissionBudget(const std::size_t lane) const {
+    return this->missionBudget[lane];
+}
+
+int RobotLanes::getStepCount(const std::size_t lane) const {
+    return this->stepCount[lane];
+}
+
+int RobotLanes::getBatteryLeft(const std::size_t lane) const {
+    return this->batteryLeft[lane];
+}
+
+Coordinate RobotLanes::getLoc(const std::size_t lane) const {
+    return Coordinate(this->x[lane], this->y[lane]);
+}
+
+bool RobotLanes::budgetExceeded(const std::size_t lane) const {
+    return this->stepCount[lane] >= this->missionBudget[lane];
+}
+
+void RobotLanes::stageStep(const std::size_t lane, const Step s) {
+    this->staged[lane] = -1;
+    this->dx[lane] = s == Step::East ? 1 : s == Step::West ? -1 : 0;
+    this->dy[lane] = s == Step::North ? 1 : s == Step::South ? -1 : 0;
+    this->stay[lane] = s == Step::Stay ? -1 : 0;
+    this->finish[lane] = s == Step::Finish ? -1 : 0;
+}
+
+void RobotLanes::move() {
+    /* Masks are all ones or 0, so every rule of Robot::move becomes a branch-free select. */
+    for(std::size_t i = 0; i < this->stepCount.size(); i += LANE_WIDTH) {
+#ifdef __SSE2__
+        auto load = [i](const std::vector<std::int32_t>& v) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(v.data() + i)); };
+        auto store = [i](std::vector<std::int32_t>& v, __m128i r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(v.data() + i), r); };
+        const __m128i zero = _mm_setzero_si128();
+
+        __m128i staged = load(this->staged);
+        __m128i cap = load(this->batteryCap);
+        __m128i battery = load(this->batteryLeft);
+
+        /* Every staged step counts, but only moves if battery and budget allow and it is not Finish. */
+        __m128i steps = _mm_sub_epi32(load(this->stepCount), staged);
+        __m128i moving = _mm_andnot_si128(load(this->finish), staged);
+        moving = _mm_and_si128(moving, _mm_cmpgt_epi32(battery, _mm_set1_epi32(-1)));
+        moving = _mm_and_si128(moving, _mm_cmpgt_epi32(load(this->missionBudget), steps));
+
+        __m128i x = _mm_add_epi32(load(this->x), _mm_and_si128(load(this->dx), moving));
+        __m128i y = _mm_add_epi32(load(this->y), _mm_and_si128(load(this->dy), moving));
+        __m128i onDock = _mm_and_si128(_mm_cmpeq_epi32(x, zero), _mm_cmpeq_epi32(y, zero));
+
+        /* Any move costs battery except staying on dock. */
+        __m128i cost = _mm_andnot_si128(_mm_and_si128(load(this->stay), onDock), moving);
+        battery = _mm_add_epi32(battery, cost);
+
+        /* Charge on dock, capped at capacity. */
+        __m128i charged = _mm_add_epi32(battery, load(this->chargeRate));
+        __m128i over = _mm_cmpgt_epi32(charged, cap);
+        charged = _mm_or_si128(_mm_and_si128(over, cap), _mm_andnot_si128(over, charged));
+        __m128i charging = _mm_and_si128(moving, onDock);
+        battery = _mm_or_si128(_mm_and_si128(charging, charged), _mm_andnot_si128(charging, battery));
+
+        store(this->stepCount, steps);
+        store(this->batteryLeft, battery);
+        store(this->x, x);
+        store(this->y, y);
+        store(this->staged, zero);
+#else
+        for(std::size_t lane = i; lane < i + LANE_WIDTH; lane++) {
+            std::int32_t staged = this->staged[lane];
+            std::int32_t steps = this->stepCount[lane] - staged;
+            std::int32_t moving = staged & ~this->finish[lane] & -std::int32_t(this->batteryLeft[lane] >= 0)
+                                  & -std::int32_t(this->missionBudget[lane] > steps);
+
+            std::int32_t x = this->x[lane] + (this->dx[lane] & moving);
+            std::int32_t y = this->y[lane] + (this->dy[lane] & moving);
+            std::int32_t onDock = -std::int32_t(x == 0 && y == 0);
+
+            std::int32_t battery = this->batteryLeft[lane] + (moving & ~(this->stay[lane] & onDock));
+            std::int32_t charged = battery + this->chargeRate[lane];
+            if(charged > this->batteryCap[lane])
+                charged = this->batteryCap[lane];
+            std::int32_t charging = moving & onDock;
+
+            this->stepCount[lane] = steps;
+            this->batteryLeft[lane] = (charging & charged) | (~charging & battery);
+            this->x[lane] = x;
+            this->y[lane] = y;
+            this->staged[lane] = 0;
+        }
+#endif
+    }
+}
@@ -0,0 +1,150 @@
+#include "sweep_runner.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <unordered_set>
+
+bool SweepRunner::readHouseFile(const std::string houseFilePath) {
+    FileReader fr = FileReader(houseFilePath);
+    HouseLayout layout;
+    if(!fr.readHouse(layout))
+        return false;
+
+    this->house.houseSetup(layout);
+    this->houseSteps = layout.maxSteps;
+    this->houseBattery = layout.maxBattery;
+    return true;
+}
+
+bool SweepRunner::addSteps(const std::string spec) {
+    return parseList(spec, 0, this->steps);
+}
+
+bool SweepRunner::addBattery(const std::string spec) {
+    return parseList(spec, 1, this->battery);
+}
+
+void SweepRunner::setHeadless(const bool headless) {
+    this->headless = headless;
+}
+
+bool SweepRunner::run() {
+    std::error_code ec;
+    std::filesystem::create_directories(this->outputDir, ec);
+    if(ec)
+        return false;
+
+    /* Fall back to the house file's own parameters for an axis that was not swept. */
+    if(this->steps.empty())
+        this->steps.push_back(this->houseSteps);
+    if(this->battery.empty())
+        this->battery.push_back(this->houseBattery);
+
+    /* Each task only writes its own range of slots, so results need no locking. */
+    std::vector<SweepResult> results(this->steps.size() * this->battery.size());
+    {
+        ThreadPool pool;
+
+        /* Keep a few tasks per worker for stealing to balance, while filling lanes on large sweeps. */
+        size_t perTask = (results.size() + 4 * pool.size() - 1) / (4 * pool.size());
+        perTask = std::clamp<size_t>(perTask, 1, MAX_RUNS_PER_TASK);
+        for(size_t first = 0; first < results.size(); first += perTask) {
+            size_t last = std::min(first + perTask, results.size());
+            pool.submit([this, &results, first, last] {
+                simulate(first, last, results);
+            });
+        }
+        pool.wait();
+    }
+
+    bool success = writeGrid(results);
+    for(const SweepResult& result : results)
+        success = success && result.success;
+    return success;
+}
+
+bool SweepRunner::parseList(const std::string spec, const int minValue, std::vector<int>& values) {
+    std::unordered_set<int> seen(values.begin(), values.end());
+    std::string_view rest = spec;
+    while(!rest.empty()) {
+        size_t comma = rest.find(',');
+        std::string_view item = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+
+        /* Each item is "first", "first:last" or "first:last:stride". */
+        int bounds[3] = {0, 0, 1};
+        int count = 0;
+        while(true) {
+            size_t colon = item.find(':');
+            std::string_view part = item.substr(0, colon);
+            if(count == 3 || part.empty())
+                return false;
+
+            auto [ptr, err] = std::from_chars(part.data(), part.data() + part.size(), bounds[count++]);
+            if(err != std::errc() || ptr != part.data() + part.size())
+                return false;
+            if(colon == std::string_view::npos)
+                break;
+            item = item.substr(colon + 1);
+        }
+        if(count == 1)
+            bounds[1] = bounds[0];
+        if(bounds[0] < minValue || bounds[1] < bounds[0] || bounds[2] <= 0)
+            return false;
+
+        /* Reject a range too large to sweep before expanding it, e.g. a typo like 1:100000000. */
+        long rangeSize = (static_cast<long>(bounds[1]) - bounds[0]) / bounds[2] + 1;
+        if(rangeSize > static_cast<long>(MAX_VALUES))
+            return false;
+
+        for(long v = bounds[0]; v <= bounds[1]; v += bounds[2]) {
+            if(seen.insert(static_cast<int>(v)).second)
+                values.push_back(static_cast<int>(v));
+        }
+        if(values.size() > MAX_VALUES)
+            return false;
+    }
+    return !values.empty();
+}
+
+std::string SweepRunner::outputPathFor(const int maxSteps, const int maxBattery) const {
+    std::string name = "sweep_" + std::to_string(maxSteps) + "_" + std::to_string(maxBattery) + "_output.txt";
+    return (std::filesystem::path(this->outputDir) / name).string();
+}
+
+void SweepRunner::simulate(const std::size_t first, const std::size_t last, std::vector<SweepResult>& results) const {
+    LockstepSimulation ls(this->headless);
+    for(size_t i = first; i < last; i++) {
+        int maxSteps = this->steps[i / this->battery.size()];
+        int maxBattery = this->battery[i % this->battery.size()];
+        ls.addMission(this->house, maxSteps, maxBattery, outputPathFor(maxSteps, maxBattery));
+    }
+
+    ls.run();
+    for(size_t i = first; i < last; i++) {
+        if(ls.outputWritten(i - first))
+            results[i] = SweepResult{true, ls.getSummary(i - first)};
+        else
+            results[i] = SweepResult{false, MissionSummary()};
+    }
+}
+
+bool SweepRunner::writeGrid(const std::vector<SweepResult>& results) const {
+    std::ofstream f = std::ofstream(std::filesystem::path(this->outputDir) / SWEEP_FILE);
+    if(f.fail())
+        return false;
+
+    /* Runs that could not be written are reported with an ERROR status and no counts. */
+    f << "MaxSteps,MaxBattery,NumSteps,DirtLeft,Status" << std::endl;
+    for(size_t i = 0; i < results.size(); i++) {
+        f << this->steps[i / this->battery.size()] << "," << this->battery[i % this->battery.size()] << ",";
+        if(results[i].success)
+            f << results[i].summary.numSteps << "," << results[i].summary.dirtLeft << "," << results[i].summary.status << std::endl;
+        else
+            f << ",,ERROR" << std::endl;
+    }
+    return f.good();
+}
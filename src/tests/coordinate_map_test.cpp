@@ -0,0 +1,105 @@
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include "coordinate_map.h"
+#include "hash.h"
+#include "unit_test.h"
+
+/* Every entry stays reachable, and the table stays within its 7/8 load factor, as it grows past each threshold. */
+TEST(CoordinateMapGrowsAcrossLoadFactor) {
+    CoordinateMap<int> map;
+    std::size_t lastCapacity = 0, grows = 0;
+    for(int i = 0; i < 5000; i++) {
+        CHECK(map.insert(Coordinate(i % 71 - 35, i / 71 - 35), i));
+        CHECK(map.size() * 8 <= map.capacity() * 7);
+        if(map.capacity() != lastCapacity) {
+            grows++;
+            lastCapacity = map.capacity();
+
+            /* Right after a rehash, every entry so far must have moved over. */
+            for(int j = 0; j <= i; j++) {
+                const int* v = map.find(Coordinate(j % 71 - 35, j / 71 - 35));
+                CHECK(v != nullptr && *v == j);
+            }
+        }
+    }
+    CHECK(grows > 5);
+    CHECK(map.size() == 5000);
+}
+
+/* Keys that were never inserted are not found, however full the table. */
+TEST(CoordinateMapMissesAbsentKeys) {
+    CoordinateMap<int> map;
+    for(int x = 0; x < 100; x++) {
+        for(int y = 0; y < 100; y++)
+            map[Coordinate(x, y)] = x * 100 + y;
+    }
+
+    for(int x = -50; x < 150; x++) {
+        for(int y = -50; y < 150; y++) {
+            bool inserted = x >= 0 && x < 100 && y >= 0 && y < 100;
+            CHECK(map.count(Coordinate(x, y)) == (inserted ? 1u : 0u));
+            CHECK((map.find(Coordinate(x, y)) != nullptr) == inserted);
+        }
+    }
+    CHECK(!map.insert(Coordinate(5, 5), -1));
+    CHECK(*map.find(Coordinate(5, 5)) == 505);
+}
+
+/* Negative coordinates, as found west and south of the dock, hash apart from each other and their mirrors. */
+TEST(CoordinateHashSeparatesNegativeCoordinates) {
+    std::unordered_set<std::size_t> hashes;
+    int n = 0;
+    for(int x = -20; x <= 20; x++) {
+        for(int y = -20; y <= 20; y++, n++)
+            hashes.insert(cHash{}(Coordinate(x, y)));
+    }
+    CHECK(hashes.size() == static_cast<std::size_t>(n));
+    CHECK(cHash{}(Coordinate(-1, 0)) != cHash{}(Coordinate(0, -1)));
+    CHECK(cHash{}(Coordinate(-1, -1)) != cHash{}(Coordinate(1, 1)));
+    CHECK(cHash{}(Coordinate(-1, 2)) != cHash{}(Coordinate(2, -1)));
+
+    CoordinateMap<int> map;
+    map[Coordinate(-1, 0)] = 1;
+    map[Coordinate(0, -1)] = 2;
+    map[Coordinate(-2147483647 - 1, -1)] = 3;
+    CHECK(*map.find(Coordinate(-1, 0)) == 1);
+    CHECK(*map.find(Coordinate(0, -1)) == 2);
+    CHECK(*map.find(Coordinate(-2147483647 - 1, -1)) == 3);
+    CHECK(map.find(Coordinate(-1, -1)) == nullptr);
+}
+
+/* Random inserts, erases and lookups agree with a standard map, including over reused tombstones. */
+TEST(CoordinateMapMatchesUnorderedMap) {
+    std::mt19937 rng(390);
+    std::uniform_int_distribution<int> coord(-40, 40), op(0, 2);
+    CoordinateMap<int> map;
+    std::unordered_map<Coordinate, int, cHash> reference;
+
+    for(int i = 0; i < 200000; i++) {
+        Coordinate c(coord(rng), coord(rng));
+        switch(op(rng)) {
+            case 0:
+                CHECK(map.insert(c, i) == reference.emplace(c, i).second);
+                break;
+            case 1:
+                CHECK(map.erase(c) == (reference.erase(c) == 1));
+                break;
+            default: {
+                const int* v = map.find(c);
+                auto it = reference.find(c);
+                CHECK((v != nullptr) == (it != reference.end()));
+                if(v != nullptr && it != reference.end())
+                    CHECK(*v == it->second);
+            }
+        }
+        CHECK(map.size() == reference.size());
+    }
+
+    std::size_t visited = 0;
+    map.forEach([&](const Coordinate& c, int& v) {
+        visited++;
+        CHECK(reference.count(c) == 1 && reference[c] == v);
+    });
+    CHECK(visited == reference.size());
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include "node_set.h"
+#include "unit_test.h"
+
+namespace {
+    /* Checks that the bitset and the member list of the set both hold exactly the reference members. */
+    void checkMatches(const NodeSet& set, const std::set<NodeId>& reference, const NodeId maxNode) {
+        CHECK(set.size() == reference.size());
+        CHECK(set.empty() == reference.empty());
+
+        std::vector<NodeId> members = set.list();
+        std::sort(members.begin(), members.end());
+        CHECK(std::equal(members.begin(), members.end(), reference.begin(), reference.end()));
+
+        for(NodeId node = 0; node <= maxNode; node++)
+            CHECK(set.contains(node) == (reference.count(node) == 1));
+    }
+}
+
+/* Inserting or erasing twice is a no-op, and nodes past the end of the bitset are not members. */
+TEST(NodeSetInsertEraseAreIdempotent) {
+    NodeSet set;
+    CHECK(!set.contains(0));
+    CHECK(!set.contains(1000));
+    set.erase(1000);
+    CHECK(set.empty());
+
+    set.insert(63);
+    set.insert(64);
+    set.insert(63);
+    checkMatches(set, {63, 64}, 200);
+
+    set.erase(63);
+    set.erase(63);
+    checkMatches(set, {64}, 200);
+
+    set.erase(64);
+    checkMatches(set, {}, 200);
+    set.insert(64);
+    checkMatches(set, {64}, 200);
+}
+
+/* Erasing moves the last member into the erased one's place, which must keep every position current. */
+TEST(NodeSetEraseKeepsPositionsConsistent) {
+    NodeSet set;
+    std::set<NodeId> reference;
+    for(NodeId node = 0; node < 300; node++) {
+        set.insert(node);
+        reference.insert(node);
+    }
+
+    /* Erase from the front, the middle and the back, each swapping a different member into place. */
+    for(NodeId node : {NodeId(0), NodeId(150), NodeId(299), NodeId(1), NodeId(298), NodeId(64), NodeId(128)}) {
+        set.erase(node);
+        reference.erase(node);
+        checkMatches(set, reference, 320);
+    }
+}
+
+/* eraseIf removes exactly the members matching the predicate, while it swaps members around. */
+TEST(NodeSetEraseIfRemovesMatches) {
+    NodeSet set;
+    std::set<NodeId> reference;
+    for(NodeId node = 0; node < 500; node += 3) {
+        set.insert(node);
+        if(node % 2 == 1)
+            reference.insert(node);
+    }
+    set.eraseIf([](NodeId node) { return node % 2 == 0; });
+    checkMatches(set, reference, 520);
+}
+
+/* Random inserts and erases agree with a standard set throughout. */
+TEST(NodeSetMatchesStdSet) {
+    std::mt19937 rng(390);
+    std::uniform_int_distribution<NodeId> node(0, 1000);
+    NodeSet set;
+    std::set<NodeId> reference;
+
+    for(int i = 0; i < 20000; i++) {
+        NodeId n = node(rng);
+        if(rng() % 2) {
+            set.insert(n);
+            reference.insert(n);
+        }
+        else {
+            set.erase(n);
+            reference.erase(n);
+        }
+        CHECK(set.contains(n) == (reference.count(n) == 1));
+        CHECK(set.size() == reference.size());
+    }
+    checkMatches(set, reference, 1100);
+}
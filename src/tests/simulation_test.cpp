@@ -0,0 +1,133 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "house_generator.h"
+#include "simulation.h"
+#include "unit_test.h"
+
+namespace {
+    /* An algorithm from outside the simulator, known only through "AbstractAlgorithm": it stays on the dock three
+     * times, as long as its battery meter reads charge, then finishes. */
+    class StayThenFinishAlgorithm : public AbstractAlgorithm {
+    public:
+        void setMaxSteps(size_t) {}
+        void setWallsSensor(const WallsSensor&) {}
+        void setDirtSensor(const DirtSensor&) {}
+        void setBatteryMeter(const BatteryMeter& batteryMeter) { this->batteryMeter = &batteryMeter; }
+
+        Step nextStep() {
+            if(this->stays < 3 && this->batteryMeter->getBatteryState() > 0) {
+                this->stays++;
+                return Step::Stay;
+            }
+            return Step::Finish;
+        }
+
+    private:
+        const BatteryMeter* batteryMeter = nullptr;
+        int stays = 0;
+    };
+
+    /* The simulator's algorithm, asked for one step at a time through nextStep(), with sensors read before each. */
+    class PerStepAlgorithm : public ConcreteAlgorithm {
+    public:
+        size_t nextSteps(Step* steps, const size_t maxSteps) { return AbstractAlgorithm::nextSteps(steps, maxSteps); }
+        size_t repeatStay(const size_t) { return 0; }
+    };
+
+    std::string readFile(const std::string path) {
+        std::ifstream f(path);
+        std::stringstream contents;
+        contents << f.rdbuf();
+        return contents.str();
+    }
+
+    /* Runs a mission on the house, returning its summary and output file. */
+    template <typename Algo>
+    MissionSummary runMission(const House& house, const int maxSteps, const int maxBattery, std::string& output) {
+        std::string outputPath = (std::filesystem::temp_directory_path() / "robot_tests_mission_output.txt").string();
+        Simulation<Algo> s(outputPath);
+        s.setHouse(house, maxSteps, maxBattery);
+        Algo a;
+        s.setAlgorithm(a);
+        CHECK(s.run());
+
+        output = readFile(outputPath);
+        std::filesystem::remove(outputPath);
+        return s.getSummary();
+    }
+
+    HouseLayout makeHouse() {
+        GeneratorOptions o;
+        o.rows = o.cols = 12;
+        o.dockRow = o.dockCol = 1;
+        o.maxSteps = 100;
+        o.maxBattery = 40;
+        o.seed = 25;
+
+        HouseLayout layout;
+        HouseGenerator(o).generate(layout);
+        return layout;
+    }
+}
+
+/* Simulation is defined in its header, so it runs algorithms other than the simulator's own. */
+TEST(SimulationRunsAnyAbstractAlgorithm) {
+    HouseLayout layout = makeHouse();
+    House house;
+    house.houseSetup(layout);
+    std::string outputPath = (std::filesystem::temp_directory_path() / "robot_tests_simulation_output.txt").string();
+
+    Simulation<StayThenFinishAlgorithm> s(outputPath);
+    s.setHouse(house, layout.maxSteps, layout.maxBattery);
+    StayThenFinishAlgorithm a;
+    s.setAlgorithm(a);
+    CHECK(s.run());
+
+    MissionSummary summary = s.getSummary();
+    CHECK(summary.numSteps == 4);
+    CHECK(summary.dirtLeft == house.getRemainingDirt());
+    CHECK(summary.status == "FINISHED");
+
+    CHECK(readFile(outputPath).find("Steps:\nsssF") != std::string::npos);
+
+    std::filesystem::remove(outputPath);
+}
+
+/* Batched plans and fast-forwarded stays take exactly the steps that nextStep() takes one at a time, including
+ * with batteries too small to charge (under 20) and budgets that run out mid-plan or mid-stay. */
+TEST(NextStepsMatchesNextStep) {
+    for(HouseStyle style : {HouseStyle::Open, HouseStyle::Maze, HouseStyle::Rooms}) {
+        for(int maxBattery : {12, 19, 40, 120}) {
+            for(int maxSteps : {37, 300, 5000}) {
+                GeneratorOptions o;
+                o.rows = o.cols = 18;
+                o.style = style;
+                o.roomSize = 6;
+                o.dirtDensity = 0.7;
+                o.maxSteps = maxSteps;
+                o.maxBattery = maxBattery;
+                o.seed = maxSteps + maxBattery;
+
+                HouseLayout layout;
+                HouseGenerator(o).generate(layout);
+                House house;
+                house.houseSetup(layout);
+
+                std::string expected, batched, specialized;
+                MissionSummary e = runMission<PerStepAlgorithm>(house, maxSteps, maxBattery, expected);
+                MissionSummary b = runMission<ConcreteAlgorithm>(house, maxSteps, maxBattery, batched);
+                MissionSummary sp = runMission<ConcreteSpecializedAlgorithm>(house, maxSteps, maxBattery, specialized);
+
+                CHECK(!expected.empty());
+                CHECK(batched == expected);
+                CHECK(specialized == expected);
+                for(const MissionSummary& summary : {b, sp}) {
+                    CHECK(summary.numSteps == e.numSteps);
+                    CHECK(summary.dirtLeft == e.dirtLeft);
+                    CHECK(summary.status == e.status);
+                }
+            }
+        }
+    }
+}
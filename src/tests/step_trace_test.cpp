@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include "step_trace.h"
+#include "unit_test.h"
+
+namespace {
+    const char STEP_CHARS[] = {'N', 'E', 'S', 'W', 's', 'F'};
+
+    std::string tracePath(const std::string name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    /* Records a run of steps, alternating between single calls and one bulk call so that both paths are covered. */
+    void record(StepTraceWriter& writer, std::string& expected, const Step s, const std::uint64_t times) {
+        if(expected.size() % 2 == 0)
+            writer.recordSteps(s, times);
+        else {
+            for(std::uint64_t i = 0; i < times; i++)
+                writer.recordStep(s);
+        }
+        expected.append(times, STEP_CHARS[static_cast<int>(s)]);
+    }
+
+    /* Writes a trace of lone steps, literal pairs and runs on either side of every record boundary (2, 3, 17, 18
+     * and multi-byte varint lengths), and runs long enough to span several seek index intervals. */
+    std::string writeTrace(const std::string path) {
+        StepTraceWriter writer(path);
+        CHECK(writer.open(1 << 30, 77));
+
+        std::string expected;
+        std::mt19937 rng(19);
+        const std::uint64_t lengths[] = {1, 2, 3, 4, 16, 17, 18, 19, 145, 146, 20000};
+        for(int round = 0; round < 400; round++) {
+            Step s = static_cast<Step>(rng() % 5);
+            record(writer, expected, s, lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))]);
+        }
+        record(writer, expected, Step::North, 1);
+        record(writer, expected, Step::Stay, 3 * StepTraceWriter::INDEX_INTERVAL + 5);
+        for(int i = 0; i < 5000; i++)
+            record(writer, expected, static_cast<Step>(rng() % 4), 1);
+        record(writer, expected, Step::East, StepTraceWriter::INDEX_INTERVAL);
+        record(writer, expected, Step::Finish, 1);
+
+        CHECK(writer.close(12, "FINISHED"));
+        return expected;
+    }
+
+    /* Decodes the rest of the trace one run at a time. */
+    std::string decodeRuns(StepTraceReader& reader) {
+        std::string steps;
+        Step s;
+        std::uint64_t length;
+        while(reader.nextRun(s, length)) {
+            CHECK(length > 0);
+            steps.append(length, STEP_CHARS[static_cast<int>(s)]);
+        }
+        return steps;
+    }
+}
+
+/* The header round-trips, and the whole trace decodes back to the recorded steps, as text and as runs. */
+TEST(StepTraceRoundTrips) {
+    std::string path = tracePath("robot_tests_round_trip.bin");
+    std::string expected = writeTrace(path);
+
+    StepTraceReader reader(path);
+    CHECK(reader.open());
+    const StepTraceHeader& header = reader.getHeader();
+    CHECK(header.maxSteps == 1 << 30);
+    CHECK(header.maxBattery == 77);
+    CHECK(header.indexInterval == StepTraceWriter::INDEX_INTERVAL);
+    CHECK(header.numSteps == expected.size());
+    CHECK(header.indexCount >= 1);
+    CHECK(header.indexCount <= header.numSteps / header.indexInterval + 1);
+    CHECK(header.dirtLeft == 12);
+    CHECK(header.status == "FINISHED");
+
+    std::string text;
+    CHECK(reader.readText(text, expected.size() + 100) == expected.size());
+    CHECK(text == expected);
+
+    CHECK(reader.seek(0));
+    CHECK(decodeRuns(reader) == expected);
+
+    std::filesystem::remove(path);
+}
+
+/* Seeking to any step, including those around index entries and inside long runs, matches a plain decode. */
+TEST(StepTraceSeekMatchesPlainDecode) {
+    std::string path = tracePath("robot_tests_seek.bin");
+    std::string expected = writeTrace(path);
+
+    StepTraceReader reader(path);
+    CHECK(reader.open());
+
+    std::vector<std::uint64_t> targets = {0, 1, 2, expected.size() - 2, expected.size() - 1};
+    for(std::uint64_t k = 1; k * StepTraceWriter::INDEX_INTERVAL < expected.size(); k++) {
+        for(std::uint64_t step = k * StepTraceWriter::INDEX_INTERVAL - 2; step <= k * StepTraceWriter::INDEX_INTERVAL + 2; step++)
+            targets.push_back(step);
+    }
+    std::mt19937 rng(7);
+    for(int i = 0; i < 200; i++)
+        targets.push_back(rng() % expected.size());
+
+    for(std::uint64_t step : targets) {
+        CHECK(reader.seek(step));
+        std::string text;
+        std::uint64_t count = reader.readText(text, 300);
+        CHECK(count == std::min<std::uint64_t>(300, expected.size() - step));
+        CHECK(text == expected.substr(step, 300));
+    }
+
+    /* Runs decoded after a seek start exactly at the target and cover the rest of the trace. */
+    std::uint64_t step = 2 * StepTraceWriter::INDEX_INTERVAL + 1;
+    CHECK(reader.seek(step));
+    CHECK(decodeRuns(reader) == expected.substr(step));
+
+    CHECK(!reader.seek(expected.size() + 1));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,55 @@
+#include "unit_test.h"
+
+#include <iostream>
+#include <regex>
+
+int TestRunner::failures = 0;
+
+std::deque<TestRunner::Test>& TestRunner::registry() {
+    static std::deque<Test> tests;
+    return tests;
+}
+
+bool TestRunner::registerTest(std::string name, std::function<void()> fn) {
+    registry().push_back(Test{name, fn});
+    return true;
+}
+
+void TestRunner::fail(const char* file, int line, const std::string expr) {
+    std::cout << "    " << file << ":" << line << ": CHECK(" << expr << ") failed" << std::endl;
+    failures++;
+}
+
+int TestRunner::main(int argc, char** argv) {
+    std::string filter = ".";
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if(arg.rfind("--test_filter=", 0) == 0)
+            filter = arg.substr(std::string("--test_filter=").size());
+        else {
+            std::cerr << "Unknown argument: " << arg << ". USAGE: ./robot_tests [--test_filter=<regex>]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::regex re(filter);
+    int run = 0, failed = 0;
+    for(const Test& t : registry()) {
+        if(!std::regex_search(t.name, re))
+            continue;
+
+        failures = 0;
+        std::cout << "[ RUN  ] " << t.name << std::endl;
+        t.fn();
+        std::cout << (failures == 0 ? "[  OK  ] " : "[ FAIL ] ") << t.name << std::endl;
+        run++;
+        failed += failures != 0;
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed." << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    return TestRunner::main(argc, argv);
+}
@@ -0,0 +1,110 @@
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "house_generator.h"
+
+#define USAGE "USAGE: ./house_gen --rows <n> --cols <n> --out <houseFilePath> [--style open|maze|rooms]" \
+              " [--dirt none|uniform|clustered] [--dirt-density <p>] [--wall-density <p>] [--room-size <n>]" \
+              " [--dock <row>,<col>|center|random] [--max-steps <n>] [--max-battery <n>] [--seed <n>] [--name <name>]"
+
+/* Parses a whole argument as a number, returning false on any trailing input. */
+template <typename T>
+bool parseNumber(const std::string& s, T& value) {
+    auto [ptr, err] = std::from_chars(s.data(), s.data() + s.size(), value);
+    return err == std::errc() && ptr == s.data() + s.size();
+}
+
+bool parseDouble(const std::string& s, double& value) {
+    char* end = nullptr;
+    value = std::strtod(s.c_str(), &end);
+    return !s.empty() && *end == '\0';
+}
+
+int main(int argc, char** argv) {
+    GeneratorOptions o;
+    std::string outPath, name, dock = "random";
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if(i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << ". " << USAGE << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        bool ok = true;
+        if(arg == "--rows")
+            ok = parseNumber(value, o.rows) && o.rows > 0;
+        else if(arg == "--cols")
+            ok = parseNumber(value, o.cols) && o.cols > 0;
+        else if(arg == "--out")
+            outPath = value;
+        else if(arg == "--name")
+            name = value;
+        else if(arg == "--style")
+            ok = HouseGenerator::parseStyle(value, o.style);
+        else if(arg == "--dirt") {
+            if(value == "none")
+                o.dirt = DirtStyle::None;
+            else if(value == "uniform")
+                o.dirt = DirtStyle::Uniform;
+            else if(value == "clustered")
+                o.dirt = DirtStyle::Clustered;
+            else
+                ok = false;
+        }
+        else if(arg == "--dirt-density")
+            ok = parseDouble(value, o.dirtDensity) && o.dirtDensity >= 0 && o.dirtDensity <= 1;
+        else if(arg == "--wall-density")
+            ok = parseDouble(value, o.wallDensity) && o.wallDensity >= 0 && o.wallDensity <= 1;
+        else if(arg == "--room-size")
+            ok = parseNumber(value, o.roomSize) && o.roomSize >= 4;
+        else if(arg == "--dock")
+            dock = value;
+        else if(arg == "--max-steps")
+            ok = parseNumber(value, o.maxSteps) && o.maxSteps > 0;
+        else if(arg == "--max-battery")
+            ok = parseNumber(value, o.maxBattery) && o.maxBattery > 0;
+        else if(arg == "--seed")
+            ok = parseNumber(value, o.seed);
+        else {
+            std::cerr << "Unknown argument: " << arg << ". " << USAGE << std::endl;
+            return 1;
+        }
+
+        if(!ok) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return 1;
+        }
+    }
+    if(o.rows == 0 || o.cols == 0 || outPath.empty()) {
+        std::cerr << "Too few arguments. " << USAGE << std::endl;
+        return 1;
+    }
+
+    /* The dock is placed on the free space closest to the requested one. */
+    if(dock == "center") {
+        o.dockRow = o.rows / 2;
+        o.dockCol = o.cols / 2;
+    }
+    else if(dock != "random") {
+        size_t comma = dock.find(',');
+        if(comma == std::string::npos || !parseNumber(dock.substr(0, comma), o.dockRow) || !parseNumber(dock.substr(comma + 1), o.dockCol)
+           || o.dockRow < 0 || o.dockCol < 0) {
+            std::cerr << "Invalid value for --dock: " << dock << std::endl;
+            return 1;
+        }
+    }
+
+    if(name.empty())
+        name = "Generated house " + std::to_string(o.rows) + "x" + std::to_string(o.cols) + " seed " + std::to_string(o.seed);
+
+    HouseLayout layout;
+    HouseGenerator(o).generate(layout);
+    if(!HouseGenerator::write(layout, name, outPath)) {
+        std::cerr << "Unable to write house file due to I/O error." << std::endl;
+        return 1;
+    }
+    return 0;
+}
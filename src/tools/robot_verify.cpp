@@ -0,0 +1,37 @@
+#include <iostream>
+#include <string>
+#include "csv.h"
+#include "replay_verifier.h"
+
+#define USAGE "USAGE: ./robot_verify <houseFilePath> <outputOrStepTraceFilePath>..., which replays every recorded" \
+              " mission on the house and prints one CSV row per mission"
+
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        std::cerr << "Too few arguments. " << USAGE << std::endl;
+        return 1;
+    }
+
+    ReplayVerifier v;
+    if(!v.readHouseFile(argv[1])) {
+        std::cerr << "Unable to read house file due to I/O error or invalid input." << std::endl;
+        return 1;
+    }
+
+    /* Missions that fail verification still report what was replayed up to the violation. */
+    bool allValid = true;
+    std::cout << "File,Valid,NumSteps,DirtLeft,Status,OnDock,MoveSteps,CleaningSteps,ChargingSteps,DirtCleaned,Score,ErrorStep,Error" << std::endl;
+    for(int i = 2; i < argc; i++) {
+        bool valid = v.verify(argv[i]);
+        allValid = allValid && valid;
+
+        const ReplayReport& r = v.getReport();
+        std::cout << csvField(argv[i]) << "," << (valid ? "yes" : "no") << "," << r.numSteps << "," << r.dirtLeft << "," << r.status << ","
+                  << (r.onDock ? "yes" : "no") << "," << r.moveSteps << "," << r.cleaningSteps << "," << r.chargingSteps << ","
+                  << r.dirtCleaned << "," << r.score << ",";
+        if(r.errorStep > 0)
+            std::cout << r.errorStep;
+        std::cout << "," << csvField(r.error) << std::endl;
+    }
+    return allValid ? 0 : 1;
+}
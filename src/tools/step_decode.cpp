@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include "step_trace.h"
+
+#define USAGE "USAGE: ./step_decode <stepTraceFilePath> [--out <outputFilePath>] [--from <step>] [--count <n>]," \
+              " which writes the mission as an output file, or only the steps from --from onwards if either" \
+              " --from or --count is given"
+
+/* Steps decoded at a time, so memory stays constant however long the mission. */
+#define CHUNK_STEPS (1 << 20)
+
+/* Parses a whole argument as a number, returning false on any trailing input. */
+bool parseNumber(const std::string& s, std::uint64_t& value) {
+    auto [ptr, err] = std::from_chars(s.data(), s.data() + s.size(), value);
+    return err == std::errc() && ptr == s.data() + s.size();
+}
+
+/* Decodes up to count steps from the reader's position to the stream, one chunk at a time, returning how many. */
+std::uint64_t writeSteps(StepTraceReader& reader, std::ostream& out, const std::uint64_t count) {
+    std::string chunk;
+    std::uint64_t written = 0;
+    while(written < count) {
+        chunk.clear();
+        std::uint64_t read = reader.readText(chunk, std::min<std::uint64_t>(count - written, CHUNK_STEPS));
+        out << chunk;
+        if(read == 0)
+            break;
+        written += read;
+    }
+    return written;
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        std::cerr << "Too few arguments. " << USAGE << std::endl;
+        return 1;
+    }
+
+    std::string traceFilePath = argv[1], outPath;
+    std::uint64_t from = 0, count = std::numeric_limits<std::uint64_t>::max();
+    bool stepsOnly = false;
+    for(int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if(i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << ". " << USAGE << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        bool ok = true;
+        if(arg == "--out")
+            outPath = value;
+        else if(arg == "--from")
+            ok = stepsOnly = parseNumber(value, from);
+        else if(arg == "--count")
+            ok = stepsOnly = parseNumber(value, count);
+        else {
+            std::cerr << "Unknown argument: " << arg << ". " << USAGE << std::endl;
+            return 1;
+        }
+        if(!ok) {
+            std::cerr << "Invalid value for " << arg << ": " << value << ". " << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    StepTraceReader reader(traceFilePath);
+    if(!reader.open()) {
+        std::cerr << "Unable to read step trace due to I/O error or invalid input." << std::endl;
+        return 1;
+    }
+    const StepTraceHeader& header = reader.getHeader();
+    if(!reader.seek(from)) {
+        std::cerr << "Step " << from << " is past the end of the trace, which has " << header.numSteps << " steps." << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if(!outPath.empty()) {
+        file.open(outPath);
+        if(file.fail()) {
+            std::cerr << "Unable to write to output file due to I/O error." << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outPath.empty() ? std::cout : file;
+
+    /* Laid out as the simulator's output file. */
+    if(!stepsOnly) {
+        out << "NumSteps = " << header.numSteps << std::endl;
+        out << "DirtLeft = " << header.dirtLeft << std::endl;
+        out << "Status = " << header.status << std::endl;
+        out << "Steps:" << std::endl;
+    }
+    std::uint64_t written = writeSteps(reader, out, count);
+    if(!out.good()) {
+        std::cerr << "Unable to write to output file due to I/O error." << std::endl;
+        return 1;
+    }
+
+    /* Every step up to the count or the end of the trace must decode. */
+    if(written < std::min(count, header.numSteps - from)) {
+        std::cerr << "Step trace is corrupt after step " << from + written << "." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,152 +1,98 @@
 #include "file_reader.h"
 
-int FileReader::readMaxSteps() const {
-    std::ifstream f = std::ifstream(this->infilePath);
-    if(f.fail()) 
-        return -1;
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool FileReader::readHouse(HouseLayout& layout) const {
+    int fd = open(this->infilePath.c_str(), O_RDONLY);
+    if(fd == -1)
+        return false;
 
-    /* MaxSteps is on Line #2. */
-    std::string str;
-    for(int i = 0; i < 2; i++) {
-        if(!getline(f, str)) 
-            return -1;
+    struct stat st;
+    if(fstat(fd, &st) == -1) {
+        close(fd);
+        return false;
     }
-    
-    return parseLine(str, "MaxSteps");
-}
-
-int FileReader::readMaxBattery() const {
-    std::ifstream f = std::ifstream(this->infilePath);
-    if(f.fail()) 
-        return -1;
 
-    /* MaxBattery is on Line #3. */
-    std::string str;
-    for(int i = 0; i < 3; i++) {
-        if(!getline(f, str)) 
-            return -1;
+    /* An empty file cannot be mapped and holds no parameters. */
+    if(st.st_size == 0) {
+        close(fd);
+        return false;
     }
-    
-    return parseLine(str, "MaxBattery");
-}
 
-int FileReader::readRowCount() const {
-    std::ifstream f = std::ifstream(this->infilePath);
-    if(f.fail()) 
-        return -1;
+    /* Map the whole file once, the descriptor is no longer needed afterwards. */
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED)
+        return false;
+    madvise(addr, st.st_size, MADV_SEQUENTIAL);
 
-    /* Rows is on Line #4. */
-    std::string str;
-    for(int i = 0; i < 4; i++) {
-        if(!getline(f, str)) 
-            return -1;
-    }
-    
-    return parseLine(str, "Rows");
+    bool success = parseHouse(std::string_view(static_cast<const char*>(addr), st.st_size), layout);
+    munmap(addr, st.st_size);
+    return success;
 }
 
-int FileReader::readColCount() const {
-    std::ifstream f = std::ifstream(this->infilePath);
-    if(f.fail()) 
-        return -1;
+bool FileReader::parseHouse(std::string_view data, HouseLayout& layout) const {
+    /* Line #1 is the house name and is ignored. */
+    std::string_view line;
+    if(!nextLine(data, line))
+        return false;
 
-    /* Cols is on Line #5. */
-    std::string str;
-    for(int i = 0; i < 5; i++) {
-        if(!getline(f, str)) 
-            return -1;
+    /* Lines #2-#5 hold the mission parameters. */
+    const std::string_view keys[] = {"MaxSteps", "MaxBattery", "Rows", "Cols"};
+    int values[4];
+    for(int i = 0; i < 4; i++) {
+        if(!nextLine(data, line))
+            return false;
+        if((values[i] = parseLine(line, keys[i])) == -1)
+            return false;
     }
-    
-    return parseLine(str, "Cols");
-}
+    layout.maxSteps = values[0];
+    layout.maxBattery = values[1];
+    layout.rows = values[2];
+    layout.cols = values[3];
+    layout.cells.assign(size_t(layout.rows) * layout.cols, 0);
 
-bool FileReader::readSpaces(std::unordered_set<Coordinate, cHash>& spaces, std::unordered_map<Coordinate, int, cHash>& dirtLevel) const {
-    /* Don't read rows/cols past the bounds. */
-    int row_bound = readRowCount();
-    int col_bound = readColCount();
-    if(row_bound == -1 || col_bound == -1)
-        return false;
+    /* House starts at line 6. Validate, locate the charging dock and store cells in the same pass. */
+    bool dockFound = false;
 
-    /* Skip to Line #5. */
-    std::ifstream f = std::ifstream(this->infilePath);
-    if(f.fail()) 
-        return -1;
-
-    std::string str;
-    for(int i = 0; i < 5; i++) {
-        if(!getline(f, str)) 
-            return -1;
-    }
-    
-    /* House starts at line 6. Validate house and get charging dock location on first pass. */
-    int dock_found = false;
-    int row = 0, dock_row = 0, dock_col = 0;
+    for(int row = 0; row < layout.rows; row++) {
+        /* Read next line if any, otherwise, the row is padded out with empty spaces. */
+        if(!nextLine(data, line))
+            line = std::string_view();
 
-    while(getline(f, str)) {
         /* Meet bound constraints. */
-        if(row >= row_bound) 
-            break;
-        if(str.length() > col_bound) 
-            str = str.substr(0, col_bound);
+        if(line.length() > size_t(layout.cols))
+            line = line.substr(0, layout.cols);
 
         /* Check for correct formatting. */
-        if(str.find_first_not_of("W0123456789D ") != std::string::npos)
+        if(line.find_first_not_of("W0123456789D ") != std::string_view::npos)
             return false;
-        if(int temp = str.find('D'); temp != std::string::npos) {
-            if(dock_found) 
+        if(size_t temp = line.find('D'); temp != std::string_view::npos) {
+            if(dockFound)
                 return false;
-            dock_found = true;
-            dock_row = row;
-            dock_col = temp;
+            dockFound = true;
+            layout.dockRow = row;
+            layout.dockCol = temp;
         }
-        row++;
-    }
-    if(!dock_found)
-        return false;
-
-    /* Jump back to Line #5. */
-    f.clear();
-    f.seekg(0);
-    for(int i = 0; i < 5; i++) {
-        if(!getline(f, str)) 
-            return -1;
-    }
-
-    /* Store relevant information on second pass. */
-    row = 0;
-    Coordinate space;
-    int dirt = 0;
-
-    while(row < row_bound) {
-        /* Read next line if any, otherwise, wait for space padding. */
-        if(!getline(f, str))
-            str = "";
-
-        /* Meet bound constraints. */
-        if(str.length() > col_bound) 
-            str = str.substr(0, col_bound);
-
-        /* Pad out empty spaces with spaces. */
-        while(str.length() < col_bound)
-            str += " ";
 
         /* Store relevant information. */
-        for(int i = 0; i < str.length(); i++) {
-            if(char c = str.at(i); c != 'W') {
-                space.x = i - dock_col;
-                space.y = dock_row - row;
-                dirt = (c == 'D' || c == ' ') ? 0 : int(c) - '0';
-
-                spaces.insert(space);
-                dirtLevel.insert({space, dirt});
-            }
+        signed char* cells = layout.cells.data() + size_t(row) * layout.cols;
+        for(size_t i = 0; i < line.length(); i++) {
+            char c = line[i];
+            if(c == 'W')
+                cells[i] = HouseLayout::WALL;
+            else if(c != 'D' && c != ' ')
+                cells[i] = c - '0';
         }
-        row++;
     }
-    return true;
-}   
+    return dockFound;
+}
 
-int FileReader::parseLine(std::string line, std::string startsWith) const {
+int FileReader::parseLine(std::string_view line, std::string_view startsWith) const {
     int lineLen = line.length();
     int swLen = startsWith.length();
 
@@ -179,11 +125,32 @@ int FileReader::parseLine(std::string line, std::string startsWith) const {
     /* Did not match or empty string after match. */
     if(!equalsFound || valIdx == line.length())
         return -1;
-    
+
     /* Value is not numeric. */
     line = line.substr(valIdx);
-    if(line.find_first_not_of("0123456789") != std::string::npos)
+    if(line.find_first_not_of("0123456789") != std::string_view::npos)
+        return -1;
+
+    /* Value does not fit. */
+    int value;
+    if(std::from_chars(line.data(), line.data() + line.length(), value).ec != std::errc())
         return -1;
 
-    return std::stoi(line);
-}
\ No newline at end of file
+    return value;
+}
+
+bool FileReader::nextLine(std::string_view& data, std::string_view& line) {
+    if(data.empty())
+        return false;
+
+    size_t end = data.find('\n');
+    if(end == std::string_view::npos) {
+        line = data;
+        data = std::string_view();
+    }
+    else {
+        line = data.substr(0, end);
+        data = data.substr(end + 1);
+    }
+    return true;
+}
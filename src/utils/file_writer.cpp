@@ -1,74 +1,137 @@
 #include "file_writer.h"
 
-void FileWriter::recordStep(const Step s) {
-    if(s == Step::North)
-        this->steps += "N";
-    if(s == Step::West)
-        this->steps += "W";
-    if(s == Step::South)
-        this->steps += "S";
-    if(s == Step::East) 
-        this->steps += "E";
-    if(s == Step::Stay) 
-        this->steps += "s";
-    if(s == Step::Finish)
-        this->steps += "F";
-}
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    /* Text of each step, in the order of the Step enum. */
+    constexpr char STEP_CHARS[] = "NESWsF";
 
-bool FileWriter::recordResults(const int totalSteps, const int dirtLeft, const int batteryLeft) const {
-    return setupOfile() && writeStepCount(totalSteps) && writeDirtLeft(dirtLeft) && writeRobotStatus(batteryLeft) && writeSteps();
+    /* Bytes copied at a time when joining spilled steps to the output file. */
+    constexpr std::size_t COPY_SIZE = 1 << 20;
 }
 
-bool FileWriter::setupOfile() const {
-    /* Output file already exists, attempt to remove. */
-    std::ifstream in = std::ifstream(OFILE);
-    if(in.good() && remove(OFILE) != 0) 
-        return false;
+FileWriter::~FileWriter() {
+    /* Results were never written, drop what was spilled. */
+    if(this->writer.joinable()) {
+        stopWriter();
+        std::remove(spillPath().c_str());
+    }
+}
 
-    /* Create output file.*/
-    std::ofstream out = std::ofstream(OFILE, std::ios::out);
-    return out.good();
+void FileWriter::recordStep(const Step s) {
+    this->steps.push_back(STEP_CHARS[static_cast<int>(s)]);
+    if(s == Step::Finish)
+        this->finished = true;
+    if(this->steps.size() >= BLOCK_SIZE)
+        handOff();
 }
 
-bool FileWriter::writeStepCount(const int totalSteps) const {
-    std::ofstream f = std::ofstream(OFILE, std::ios::app);
-    if(f.fail())
-        return false;
+void FileWriter::recordSteps(const Step s, std::size_t times) {
+    if(s == Step::Finish && times > 0)
+        this->finished = true;
 
-    f << "NumSteps = " << totalSteps << std::endl;
-    return true;
+    /* Fill the held steps up to a block at a time, handing off each full block. */
+    while(times > 0) {
+        std::size_t n = std::min(times, BLOCK_SIZE - this->steps.size());
+        this->steps.append(n, STEP_CHARS[static_cast<int>(s)]);
+        times -= n;
+        if(this->steps.size() >= BLOCK_SIZE)
+            handOff();
+    }
 }
 
-bool FileWriter::writeDirtLeft(const int dirtLeft) const {
-    std::ofstream f = std::ofstream(OFILE, std::ios::app);
+bool FileWriter::recordResults(const int totalSteps, const int dirtLeft, const int batteryLeft) {
+    bool spilled = this->writer.joinable();
+    if(spilled)
+        stopWriter();
+
+    /* Open once and write the summary, then the steps spilled so far, then the steps still held. */
+    std::ofstream f = std::ofstream(this->outfilePath, std::ios::out | std::ios::trunc);
     if(f.fail())
         return false;
 
+    f << "NumSteps = " << totalSteps << std::endl;
     f << "DirtLeft = " << dirtLeft << std::endl;
-    return true;
+    f << "Status = " << getRobotStatus(batteryLeft) << std::endl;
+    f << "Steps:" << std::endl;
+
+    if(spilled) {
+        std::ifstream in = std::ifstream(spillPath(), std::ios::binary);
+        std::string buffer(COPY_SIZE, '\0');
+        while(!this->failed && in.read(buffer.data(), buffer.size()).gcount() > 0)
+            f.write(buffer.data(), in.gcount());
+        in.close();
+        std::remove(spillPath().c_str());
+        if(this->failed)
+            return false;
+    }
+    f.write(this->steps.data(), this->steps.size());
+    return f.good();
 }
 
-bool FileWriter::writeRobotStatus(const int batteryLeft) const {
-    std::ofstream f = std::ofstream(OFILE, std::ios::app);
-    if(f.fail())
-        return false;
+std::string FileWriter::getRobotStatus(const int batteryLeft) const {
+    return getRobotStatus(this->finished, batteryLeft);
+}
 
+std::string FileWriter::getRobotStatus(const bool finished, const int batteryLeft) {
     /* Finished if algorithm reported, otherwise, working if battery > 0 and dead if battery <= 0. */
-    if(this->steps.find('F') != std::string::npos)
-        f << "Status = FINISHED" << std::endl;
-    else if(batteryLeft > 0) 
-        f << "Status = WORKING" << std::endl;
+    if(finished)
+        return "FINISHED";
+    else if(batteryLeft > 0)
+        return "WORKING";
     else
-        f << "Status = DEAD" << std::endl;
-    
-    return true;
+        return "DEAD";
 }
 
-bool FileWriter::writeSteps() const {
-    std::ofstream f = std::ofstream(OFILE, std::ios::app);
-    if(f.fail())
-        return false;
-    
-    f << "Steps:" << std::endl << this->steps;
-    return true;
-}
\ No newline at end of file
+std::string FileWriter::spillPath() const {
+    return this->outfilePath + ".steps";
+}
+
+void FileWriter::handOff() {
+    if(!this->writer.joinable()) {
+        this->spill.open(spillPath(), std::ios::binary | std::ios::trunc);
+        this->failed = this->spill.fail();
+        this->writer = std::thread(&FileWriter::writerLoop, this);
+    }
+
+    /* Wait for the previous block to be written, then swap buffers so recording carries on into the emptied one. */
+    {
+        std::unique_lock<std::mutex> lk(this->lock);
+        this->changed.wait(lk, [this] { return !this->pending; });
+        this->block.swap(this->steps);
+        this->pending = true;
+    }
+    this->changed.notify_all();
+    this->steps.clear();
+}
+
+void FileWriter::writerLoop() {
+    std::unique_lock<std::mutex> lk(this->lock);
+    while(true) {
+        this->changed.wait(lk, [this] { return this->pending || this->stopping; });
+        if(!this->pending)
+            return;
+
+        /* The recording thread leaves the block alone while it is pending, so write it unlocked. */
+        lk.unlock();
+        this->spill.write(this->block.data(), this->block.size());
+        bool ok = this->spill.good();
+        lk.lock();
+
+        this->failed = this->failed || !ok;
+        this->pending = false;
+        this->changed.notify_all();
+    }
+}
+
+void FileWriter::stopWriter() {
+    {
+        std::lock_guard<std::mutex> lk(this->lock);
+        this->stopping = true;
+    }
+    this->changed.notify_all();
+    this->writer.join();
+    this->spill.close();
+    this->failed = this->failed || this->spill.fail();
+}
@@ -0,0 +1,285 @@
+#include "house_generator.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include "thread_pool.h"
+
+namespace {
+    /* Salts keeping the hash of each independent decision uncorrelated. */
+    enum Salt : std::uint64_t { PILLAR = 1, RUN, CARVE, ROOM_HEIGHT, ROOM_WIDTH, TREE, EXTRA_EAST, EXTRA_SOUTH, DIRTY, NOISE, DOCK };
+}
+
+void HouseGenerator::generate(HouseLayout& layout) const {
+    layout.rows = std::max(this->options.rows, 1);
+    layout.cols = std::max(this->options.cols, 1);
+    layout.cells.assign(size_t(layout.rows) * layout.cols, HouseLayout::WALL);
+
+    /* By default the battery can cross the house twice, and the budget can visit every space four times. */
+    long long area = (long long)layout.rows * layout.cols;
+    layout.maxBattery = this->options.maxBattery > 0 ? this->options.maxBattery : 2 * (layout.rows + layout.cols);
+    layout.maxSteps = this->options.maxSteps > 0 ? this->options.maxSteps : int(std::min<long long>(4 * area, INT_MAX));
+
+    /* Every space only depends on its own position, so bands of rows are independent. */
+    {
+        ThreadPool pool;
+        for(int first = 0; first < layout.rows; first += ROWS_PER_TASK) {
+            pool.submit([this, &layout, first] {
+                int last = std::min(first + ROWS_PER_TASK, layout.rows);
+                for(int row = first; row < last; row++)
+                    fillRow(row, layout.cells.data() + size_t(row) * layout.cols);
+            });
+        }
+        pool.wait();
+    }
+
+    placeDock(layout);
+}
+
+bool HouseGenerator::write(const HouseLayout& layout, const std::string name, const std::string path) {
+    std::ofstream f(path, std::ios::binary);
+    if(f.fail())
+        return false;
+
+    f << name << "\n";
+    f << "MaxSteps = " << layout.maxSteps << "\n";
+    f << "MaxBattery = " << layout.maxBattery << "\n";
+    f << "Rows = " << layout.rows << "\n";
+    f << "Cols = " << layout.cols << "\n";
+
+    /* Format bands of rows in parallel, then write them out in order. */
+    std::vector<std::string> bands((layout.rows + ROWS_PER_TASK - 1) / ROWS_PER_TASK);
+    {
+        ThreadPool pool;
+        for(size_t band = 0; band < bands.size(); band++) {
+            pool.submit([&layout, &bands, band] {
+                int first = band * ROWS_PER_TASK;
+                int last = std::min(first + ROWS_PER_TASK, layout.rows);
+                std::string& text = bands[band];
+                text.resize(size_t(last - first) * (layout.cols + 1));
+
+                /* A lookup table keeps random dirt from defeating branch prediction. */
+                char symbols[256];
+                std::fill(symbols, symbols + 256, ' ');
+                symbols[std::uint8_t(HouseLayout::WALL)] = 'W';
+                for(int dirt = 1; dirt <= 9; dirt++)
+                    symbols[dirt] = char('0' + dirt);
+
+                char* out = text.data();
+                for(int row = first; row < last; row++) {
+                    const signed char* cells = layout.cells.data() + size_t(row) * layout.cols;
+                    for(int col = 0; col < layout.cols; col++)
+                        *out++ = symbols[std::uint8_t(cells[col])];
+                    *out++ = '\n';
+                }
+                if(layout.dockRow >= first && layout.dockRow < last)
+                    text[size_t(layout.dockRow - first) * (layout.cols + 1) + layout.dockCol] = 'D';
+            });
+        }
+        pool.wait();
+    }
+
+    for(const std::string& text : bands)
+        f.write(text.data(), text.size());
+    return f.good();
+}
+
+const char* HouseGenerator::styleName(const HouseStyle style) {
+    switch(style) {
+        case HouseStyle::Open:
+            return "open";
+        case HouseStyle::Maze:
+            return "maze";
+        default:
+            return "rooms";
+    }
+}
+
+bool HouseGenerator::parseStyle(const std::string& name, HouseStyle& style) {
+    for(HouseStyle s : {HouseStyle::Open, HouseStyle::Maze, HouseStyle::Rooms}) {
+        if(name == styleName(s)) {
+            style = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t HouseGenerator::hash(const std::int64_t a, const std::int64_t b, const std::uint64_t salt) const {
+    /* One round of the splitmix64 finalizer over the position, offset by the seed and salt. */
+    std::uint64_t h = (std::uint64_t(std::uint32_t(a)) << 32) | std::uint32_t(b);
+    h ^= this->options.seed * 0x9e3779b97f4a7c15ULL + salt * 0xd6e8feb86659fd93ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+std::uint32_t HouseGenerator::bounded(const std::uint64_t h, const std::uint32_t n) {
+    /* Scale the low 32 bits into [0, n) with a multiply instead of a division. */
+    return (std::uint64_t(std::uint32_t(h)) * n) >> 32;
+}
+
+double HouseGenerator::unit(const std::int64_t a, const std::int64_t b, const std::uint64_t salt) const {
+    return (hash(a, b, salt) >> 11) * 0x1.0p-53;
+}
+
+bool HouseGenerator::isFree(const int row, const int col) const {
+    /* The house is always surrounded by walls. */
+    if(row <= 0 || col <= 0 || row >= this->options.rows - 1 || col >= this->options.cols - 1)
+        return false;
+
+    switch(this->options.style) {
+        case HouseStyle::Maze:
+            return isFreeMaze(row, col);
+        case HouseStyle::Rooms:
+            return isFreeRooms(row, col);
+        default:
+            return this->options.wallDensity <= 0 || unit(row, col, PILLAR) >= this->options.wallDensity;
+    }
+}
+
+bool HouseGenerator::isFreeMaze(const int row, const int col) const {
+    /* Maze cells sit on odd rows and columns, with the spaces between them either passages or walls. */
+    int mazeRows = (this->options.rows - 1) / 2;
+    int mazeCols = (this->options.cols - 1) / 2;
+    if(row > 2 * mazeRows - 1 || col > 2 * mazeCols - 1)
+        return false;
+
+    /* Each maze row is split into runs of cells joined eastward. The top row is a single run. */
+    auto closesRun = [this, mazeCols](int i, int j) {
+        return j == mazeCols - 1 || (i > 0 && (hash(i, j, RUN) & 1));
+    };
+
+    if(row % 2 == 1 && col % 2 == 1)
+        return true;
+    if(row % 2 == 1)
+        return !closesRun((row - 1) / 2, col / 2 - 1);
+    if(col % 2 == 0)
+        return false;
+
+    /* Every run below the top row carves one passage north, from a cell picked at random within the run. */
+    int i = row / 2, j = (col - 1) / 2;
+    int start = j, end = j;
+    while(start > 0 && !closesRun(i, start - 1))
+        start--;
+    while(!closesRun(i, end))
+        end++;
+    return j == start + int(bounded(hash(i, end, CARVE), end - start + 1));
+}
+
+bool HouseGenerator::isFreeRooms(const int row, const int col) const {
+    /* Rooms are centered in square blocks, each block with a room fully inside the house. */
+    int size = std::max(this->options.roomSize, 4);
+    int half = size / 2;
+    int blockRows = this->options.rows - 2 >= half ? (this->options.rows - 2 - half) / size + 1 : 0;
+    int blockCols = this->options.cols - 2 >= half ? (this->options.cols - 2 - half) / size + 1 : 0;
+    if(blockRows == 0 || blockCols == 0)
+        return true;
+
+    /* Inside the room of its own block. Rooms leave at least one wall to the block edges. */
+    int blockRow = row / size, blockCol = col / size;
+    if(blockRow < blockRows && blockCol < blockCols) {
+        int halfHeight = 1 + bounded(hash(blockRow, blockCol, ROOM_HEIGHT), std::max(half - 1, 1));
+        int halfWidth = 1 + bounded(hash(blockRow, blockCol, ROOM_WIDTH), std::max(half - 1, 1));
+        if(std::abs(row - (blockRow * size + half)) <= halfHeight && std::abs(col - (blockCol * size + half)) <= halfWidth)
+            return true;
+    }
+
+    /* On a corridor between the centers of two joined rooms. */
+    if(row >= half && (row - half) % size == 0 && col >= half) {
+        int r = (row - half) / size, c = (col - half) / size;
+        if(r < blockRows && c + 1 < blockCols && linkedEast(r, c))
+            return true;
+    }
+    if(col >= half && (col - half) % size == 0 && row >= half) {
+        int r = (row - half) / size, c = (col - half) / size;
+        if(c < blockCols && r + 1 < blockRows && linkedSouth(r, c))
+            return true;
+    }
+    return false;
+}
+
+bool HouseGenerator::linkedEast(const int blockRow, const int blockCol) const {
+    /* Every room but the first joins the room west or north of it, so rooms form a spanning tree. Extra
+       corridors then add loops. */
+    int east = blockCol + 1;
+    bool eastJoinsWest = blockRow == 0 || (hash(blockRow, east, TREE) & 1);
+    return eastJoinsWest || unit(blockRow, blockCol, EXTRA_EAST) < 0.2;
+}
+
+bool HouseGenerator::linkedSouth(const int blockRow, const int blockCol) const {
+    int south = blockRow + 1;
+    bool southJoinsNorth = blockCol == 0 || !(hash(south, blockCol, TREE) & 1);
+    return southJoinsNorth || unit(blockRow, blockCol, EXTRA_SOUTH) < 0.2;
+}
+
+void HouseGenerator::fillRow(const int row, signed char* cells) const {
+    /* Clustered dirt follows smoothly interpolated value noise over a lattice. Interpolate between the two
+       lattice rows around this row once, leaving only the interpolation between lattice columns per space. */
+    std::vector<double> noise;
+    double fy = 0;
+    if(this->options.dirt == DirtStyle::Clustered) {
+        int gy = row / NOISE_SCALE;
+        fy = double(row % NOISE_SCALE) / NOISE_SCALE;
+        fy = fy * fy * (3 - 2 * fy);
+        noise.resize(this->options.cols / NOISE_SCALE + 2);
+        for(size_t gx = 0; gx < noise.size(); gx++)
+            noise[gx] = unit(gy, gx, NOISE) * (1 - fy) + unit(gy + 1, gx, NOISE) * fy;
+    }
+
+    double density = this->options.dirtDensity;
+    for(int col = 0; col < this->options.cols; col++) {
+        if(!isFree(row, col)) {
+            cells[col] = HouseLayout::WALL;
+            continue;
+        }
+
+        if(this->options.dirt == DirtStyle::Uniform) {
+            /* High bits decide whether the space is dirty, low bits how dirty. */
+            std::uint64_t h = hash(row, col, DIRTY);
+            bool dirty = (h >> 11) * 0x1.0p-53 < density;
+            cells[col] = dirty * (1 + bounded(h, 9));
+        }
+        else if(this->options.dirt == DirtStyle::Clustered) {
+            /* Dirt is both likelier and heavier around the peaks of the noise. */
+            int gx = col / NOISE_SCALE;
+            double fx = double(col % NOISE_SCALE) / NOISE_SCALE;
+            fx = fx * fx * (3 - 2 * fx);
+            double v = noise[gx] * (1 - fx) + noise[gx + 1] * fx;
+
+            bool dirty = unit(row, col, DIRTY) < 2 * density * v;
+            cells[col] = dirty * std::min(1 + int(v * 9), 9);
+        }
+        else
+            cells[col] = 0;
+    }
+}
+
+void HouseGenerator::placeDock(HouseLayout& layout) const {
+    int row = this->options.dockRow >= 0 ? std::min(this->options.dockRow, layout.rows - 1) : bounded(hash(0, 0, DOCK), layout.rows);
+    int col = this->options.dockCol >= 0 ? std::min(this->options.dockCol, layout.cols - 1) : bounded(hash(1, 0, DOCK), layout.cols);
+
+    /* Search rings of growing distance around the preferred space, in a fixed order. */
+    int maxDist = std::max(layout.rows, layout.cols);
+    for(int d = 0; d < maxDist; d++) {
+        for(int dr = -d; dr <= d; dr++) {
+            int step = (dr == -d || dr == d) ? 1 : 2 * d;
+            for(int dc = -d; dc <= d; dc += std::max(step, 1)) {
+                int r = row + dr, c = col + dc;
+                if(r < 0 || c < 0 || r >= layout.rows || c >= layout.cols || layout.at(r, c) == HouseLayout::WALL)
+                    continue;
+                layout.dockRow = r;
+                layout.dockCol = c;
+                layout.cells[size_t(r) * layout.cols + c] = 0;
+                return;
+            }
+        }
+    }
+
+    /* No free space at all, free the preferred one. */
+    layout.dockRow = row;
+    layout.dockCol = col;
+    layout.cells[size_t(row) * layout.cols + col] = 0;
+}
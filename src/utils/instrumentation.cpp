@@ -0,0 +1,23 @@
+#include "instrumentation.h"
+
+void AlgorithmStats::writeJson(std::ostream& out) const {
+    out << "{\"searches\": " << this->searches
+        << ", \"nodesExpanded\": " << this->nodesExpanded
+        << ", \"searchQueuePeak\": " << this->searchQueuePeak
+        << ", \"frontierPeak\": " << this->frontierPeak
+        << ", \"distanceUpdates\": " << this->distanceUpdates
+        << ", \"batteryReplans\": " << this->batteryReplans
+        << ", \"budgetReplans\": " << this->budgetReplans
+        << ", \"exploredReplans\": " << this->exploredReplans << "}";
+}
+
+void SimulationStats::writeJson(std::ostream& out, const AlgorithmStats& algorithm) const {
+    out << "{\n  \"moveSteps\": " << this->moveSteps
+        << ",\n  \"cleaningSteps\": " << this->cleaningSteps
+        << ",\n  \"chargingSteps\": " << this->chargingSteps
+        << ",\n  \"nextStepLatencyNs\": ";
+    this->nextStepLatency.writeJson(out);
+    out << ",\n  \"algorithm\": ";
+    algorithm.writeJson(out);
+    out << "\n}\n";
+}
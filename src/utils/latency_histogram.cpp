@@ -0,0 +1,61 @@
+#include "latency_histogram.h"
+
+#include <bit>
+#include <cmath>
+
+void LatencyHistogram::record(const std::uint64_t value) {
+    this->counts[bucketOf(value)]++;
+    this->total++;
+    this->sum += value;
+    this->min = value < this->min ? value : this->min;
+    this->max = value > this->max ? value : this->max;
+}
+
+std::uint64_t LatencyHistogram::valueAtPercentile(const double percentile) const {
+    if(this->total == 0)
+        return 0;
+
+    /* Walk buckets until the rank of the percentile is covered. */
+    std::uint64_t rank = std::uint64_t(std::ceil(percentile / 100 * this->total));
+    rank = rank == 0 ? 1 : rank;
+    std::uint64_t seen = 0;
+    for(int bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += this->counts[bucket];
+        if(seen >= rank) {
+            std::uint64_t value = highestIn(bucket);
+            return value < this->max ? value : this->max;
+        }
+    }
+    return this->max;
+}
+
+std::uint64_t LatencyHistogram::getCount() const {
+    return this->total;
+}
+
+void LatencyHistogram::writeJson(std::ostream& out) const {
+    out << "{\"count\": " << this->total
+        << ", \"min\": " << (this->total ? this->min : 0)
+        << ", \"mean\": " << (this->total ? double(this->sum) / this->total : 0)
+        << ", \"p50\": " << valueAtPercentile(50)
+        << ", \"p90\": " << valueAtPercentile(90)
+        << ", \"p99\": " << valueAtPercentile(99)
+        << ", \"p99.9\": " << valueAtPercentile(99.9)
+        << ", \"max\": " << this->max << "}";
+}
+
+int LatencyHistogram::bucketOf(const std::uint64_t value) {
+    /* Small values are exact. Above, keep the top SUB_BUCKET_BITS bits: each power of two adds HALF buckets. */
+    if(value < SUB_BUCKETS)
+        return int(value);
+    int shift = 63 - std::countl_zero(value) - (SUB_BUCKET_BITS - 1);
+    return shift * HALF + int(value >> shift);
+}
+
+std::uint64_t LatencyHistogram::highestIn(const int bucket) {
+    if(bucket < SUB_BUCKETS)
+        return bucket;
+    int shift = bucket / HALF - 1;
+    std::uint64_t mantissa = bucket - shift * HALF;
+    return ((mantissa + 1) << shift) - 1;
+}
@@ -0,0 +1,138 @@
+#include "perf_profiler.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char* const COUNTER_NAMES[PerfProfiler::COUNTERS] = {"cycles", "instructions", "cacheMisses", "branchMisses", "taskClockNs"};
+    const char* const PHASE_NAMES[static_cast<int>(PerfPhase::Count)] = {
+        "readHouseFile", "setAlgorithm", "run", "writeOutput", "getClosestAdjacentNode", "setClosestNonAdjacentNodePath", "findPathToDock"
+    };
+}
+
+PerfProfiler::PerfProfiler() : leader(-1), opened(0) {
+    this->fds.fill(-1);
+    this->slots.fill(-1);
+    for(Totals& t : this->totals)
+        t = Totals{0, {}, 0};
+}
+
+PerfProfiler::~PerfProfiler() {
+#ifdef __linux__
+    for(int fd : this->fds) {
+        if(fd != -1)
+            close(fd);
+    }
+#endif
+}
+
+bool PerfProfiler::open() {
+#ifdef __linux__
+    const std::uint32_t types[COUNTERS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+    const std::uint64_t configs[COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                             PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_TASK_CLOCK};
+
+    /* The first counter that opens leads the group, so the others are scheduled and read together with it. */
+    for(int i = 0; i < COUNTERS; i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.disabled = this->leader == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = syscall(SYS_perf_event_open, &attr, 0, -1, this->leader, 0);
+        if(fd == -1)
+            continue;
+        if(this->leader == -1)
+            this->leader = fd;
+        this->fds[i] = fd;
+        this->slots[i] = this->opened++;
+    }
+    if(this->leader == -1)
+        return false;
+
+    ioctl(this->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(this->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfProfiler::begin(const PerfPhase phase) {
+    read(this->starts[static_cast<int>(phase)]);
+}
+
+void PerfProfiler::end(const PerfPhase phase) {
+    Sample now;
+    read(now);
+    const Sample& start = this->starts[static_cast<int>(phase)];
+    Totals& t = this->totals[static_cast<int>(phase)];
+
+    /* Counters only ran for part of the phase if the kernel multiplexed them, so extrapolate. */
+    std::uint64_t enabled = now.enabled - start.enabled;
+    std::uint64_t running = now.running - start.running;
+    double scale = running > 0 && running < enabled ? double(enabled) / running : 1;
+
+    t.calls++;
+    for(int i = 0; i < COUNTERS; i++)
+        t.values[i] += (now.values[i] - start.values[i]) * scale;
+    t.wallNs += std::chrono::duration_cast<std::chrono::nanoseconds>(now.wall - start.wall).count();
+}
+
+void PerfProfiler::writeJson(std::ostream& out) const {
+    out << "{\n  \"phases\": [";
+    bool first = true;
+    for(int p = 0; p < static_cast<int>(PerfPhase::Count); p++) {
+        const Totals& t = this->totals[p];
+        if(t.calls == 0)
+            continue;
+
+        out << (first ? "\n" : ",\n") << "    {\"phase\": \"" << PHASE_NAMES[p] << "\", \"calls\": " << t.calls << ", \"wallNs\": " << t.wallNs;
+        for(int i = 0; i < COUNTERS; i++) {
+            out << ", \"" << COUNTER_NAMES[i] << "\": ";
+            if(this->fds[i] == -1)
+                out << "null";
+            else
+                out << std::uint64_t(t.values[i]);
+        }
+
+        /* Instructions per cycle, when both are counted. */
+        out << ", \"ipc\": ";
+        if(this->fds[0] != -1 && this->fds[1] != -1 && t.values[0] > 0)
+            out << t.values[1] / t.values[0];
+        else
+            out << "null";
+        out << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+}
+
+void PerfProfiler::read(Sample& sample) const {
+    sample.values.fill(0);
+    sample.enabled = sample.running = 0;
+
+#ifdef __linux__
+    /* Group read format: nr, time enabled, time running, then one value per counter in opening order. */
+    std::uint64_t buffer[3 + COUNTERS];
+    if(this->leader != -1 && ::read(this->leader, buffer, sizeof(buffer)) > 0) {
+        sample.enabled = buffer[1];
+        sample.running = buffer[2];
+        for(int i = 0; i < COUNTERS; i++) {
+            if(this->slots[i] != -1)
+                sample.values[i] = buffer[3 + this->slots[i]];
+        }
+    }
+#endif
+    sample.wall = std::chrono::steady_clock::now();
+}
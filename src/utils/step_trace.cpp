@@ -0,0 +1,348 @@
+#include "step_trace.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    /* Step codes above this are invalid, and this one pads a lone single step. */
+    constexpr int MAX_CODE = static_cast<int>(Step::Finish);
+    constexpr int PAD_CODE = 7;
+
+    /* Text of each step code, as in the output file. */
+    constexpr char STEP_CHARS[] = "NESWsF";
+
+    const char* const STATUSES[] = {"FINISHED", "WORKING", "DEAD"};
+
+    void putLE(unsigned char* p, std::uint64_t value, const int bytes) {
+        for(int i = 0; i < bytes; i++, value >>= 8)
+            p[i] = static_cast<unsigned char>(value);
+    }
+
+    std::uint64_t getLE(const unsigned char* p, const int bytes) {
+        std::uint64_t value = 0;
+        for(int i = bytes - 1; i >= 0; i--)
+            value = value << 8 | p[i];
+        return value;
+    }
+}
+
+bool StepTraceWriter::open(const int maxSteps, const int maxBattery) {
+    this->out.open(this->traceFilePath, std::ios::binary | std::ios::trunc);
+    if(this->out.fail())
+        return false;
+
+    /* The header is only known once the mission ends, reserve its room. */
+    char blank[StepTraceHeader::HEADER_SIZE] = {};
+    this->out.write(blank, sizeof(blank));
+
+    this->header = StepTraceHeader{maxSteps, maxBattery, INDEX_INTERVAL, 0, 0, 0, 0, ""};
+    this->block.clear();
+    this->block.reserve(BLOCK_SIZE);
+    this->offset = StepTraceHeader::HEADER_SIZE;
+    this->stepsEncoded = 0;
+    this->nextIndexStep = 0;
+    this->index.clear();
+    this->runCode = -1;
+    this->runLength = 0;
+    this->literalCode = -1;
+    return this->out.good();
+}
+
+void StepTraceWriter::recordStep(const Step s) {
+    recordSteps(s, 1);
+}
+
+void StepTraceWriter::recordSteps(const Step s, const std::uint64_t times) {
+    int code = static_cast<int>(s);
+    if(times == 0)
+        return;
+    this->header.numSteps += times;
+
+    if(code == this->runCode) {
+        this->runLength += times;
+        return;
+    }
+    flushRun();
+    this->runCode = code;
+    this->runLength = times;
+}
+
+bool StepTraceWriter::close(const int dirtLeft, const std::string status) {
+    flushRun();
+    flushLiteral();
+
+    /* The seek index follows the records. */
+    this->header.indexOffset = this->offset;
+    this->header.indexCount = this->index.size() / 2;
+    unsigned char entry[8];
+    for(std::uint64_t value : this->index) {
+        putLE(entry, value, 8);
+        for(unsigned char byte : entry)
+            put(byte);
+    }
+    flushBlock();
+
+    this->header.dirtLeft = dirtLeft;
+    this->header.status = status;
+    int statusCode = static_cast<int>(std::find(STATUSES, STATUSES + 3, status) - STATUSES);
+
+    unsigned char h[StepTraceHeader::HEADER_SIZE] = {};
+    std::memcpy(h, STEP_TRACE_MAGIC, sizeof(STEP_TRACE_MAGIC));
+    putLE(h + 8, StepTraceHeader::VERSION, 4);
+    putLE(h + 12, this->header.maxSteps, 4);
+    putLE(h + 16, this->header.maxBattery, 4);
+    putLE(h + 20, this->header.indexInterval, 4);
+    putLE(h + 24, this->header.numSteps, 8);
+    putLE(h + 32, this->header.indexOffset, 8);
+    putLE(h + 40, this->header.indexCount, 8);
+    putLE(h + 48, static_cast<std::uint32_t>(this->header.dirtLeft), 4);
+    h[52] = static_cast<unsigned char>(statusCode);
+
+    this->out.seekp(0);
+    this->out.write(reinterpret_cast<const char*>(h), sizeof(h));
+    this->out.close();
+    return !this->out.fail();
+}
+
+void StepTraceWriter::flushRun() {
+    if(this->runCode < 0)
+        return;
+
+    /* Runs of one or two steps are as short as single steps. */
+    if(this->runLength < 3) {
+        for(std::uint64_t i = 0; i < this->runLength; i++)
+            emitLiteral(this->runCode);
+    }
+    else {
+        flushLiteral();
+        beginRecord();
+        unsigned char head = 0x80 | this->runCode << 4;
+        if(this->runLength - 3 < 15)
+            put(head | static_cast<unsigned char>(this->runLength - 3));
+        else {
+            put(head | 15);
+            std::uint64_t rest = this->runLength - 18;
+            while(rest >= 0x80) {
+                put(static_cast<unsigned char>(rest | 0x80));
+                rest >>= 7;
+            }
+            put(static_cast<unsigned char>(rest));
+        }
+        this->stepsEncoded += this->runLength;
+    }
+    this->runCode = -1;
+}
+
+void StepTraceWriter::emitLiteral(const int code) {
+    if(this->literalCode < 0) {
+        this->literalCode = code;
+        return;
+    }
+    beginRecord();
+    put(static_cast<unsigned char>(this->literalCode << 4 | code << 1));
+    this->stepsEncoded += 2;
+    this->literalCode = -1;
+}
+
+void StepTraceWriter::flushLiteral() {
+    if(this->literalCode < 0)
+        return;
+    beginRecord();
+    put(static_cast<unsigned char>(this->literalCode << 4 | PAD_CODE << 1));
+    this->stepsEncoded++;
+    this->literalCode = -1;
+}
+
+void StepTraceWriter::beginRecord() {
+    if(this->stepsEncoded < this->nextIndexStep)
+        return;
+    this->index.push_back(this->stepsEncoded);
+    this->index.push_back(this->offset);
+    this->nextIndexStep = this->stepsEncoded + this->header.indexInterval;
+}
+
+void StepTraceWriter::put(const unsigned char byte) {
+    this->block.push_back(byte);
+    this->offset++;
+    if(this->block.size() >= BLOCK_SIZE)
+        flushBlock();
+}
+
+void StepTraceWriter::flushBlock() {
+    this->out.write(reinterpret_cast<const char*>(this->block.data()), this->block.size());
+    this->block.clear();
+}
+
+bool StepTraceReader::open() {
+    this->in.open(this->traceFilePath, std::ios::binary);
+    if(this->in.fail())
+        return false;
+
+    unsigned char h[StepTraceHeader::HEADER_SIZE];
+    if(!this->in.read(reinterpret_cast<char*>(h), sizeof(h)))
+        return false;
+    if(std::memcmp(h, STEP_TRACE_MAGIC, sizeof(STEP_TRACE_MAGIC)) != 0 || getLE(h + 8, 4) != StepTraceHeader::VERSION || h[52] > 2)
+        return false;
+
+    this->header.maxSteps = static_cast<int>(getLE(h + 12, 4));
+    this->header.maxBattery = static_cast<int>(getLE(h + 16, 4));
+    this->header.indexInterval = static_cast<std::uint32_t>(getLE(h + 20, 4));
+    this->header.numSteps = getLE(h + 24, 8);
+    this->header.indexOffset = getLE(h + 32, 8);
+    this->header.indexCount = getLE(h + 40, 8);
+    this->header.dirtLeft = static_cast<int>(static_cast<std::uint32_t>(getLE(h + 48, 4)));
+    this->header.status = STATUSES[h[52]];
+    if(this->header.indexOffset < StepTraceHeader::HEADER_SIZE)
+        return false;
+
+    /* Load the seek index, which must fill the rest of the file exactly. */
+    this->in.seekg(0, std::ios::end);
+    std::uint64_t size = static_cast<std::uint64_t>(this->in.tellg());
+    if(size < this->header.indexOffset || (size - this->header.indexOffset) / 16 != this->header.indexCount || (size - this->header.indexOffset) % 16 != 0)
+        return false;
+
+    std::vector<unsigned char> entries(this->header.indexCount * 16);
+    this->in.seekg(this->header.indexOffset);
+    if(!this->in.read(reinterpret_cast<char*>(entries.data()), entries.size()))
+        return false;
+    this->index.resize(this->header.indexCount * 2);
+    for(std::size_t i = 0; i < this->index.size(); i++)
+        this->index[i] = getLE(entries.data() + 8 * i, 8);
+
+    moveTo(StepTraceHeader::HEADER_SIZE, 0);
+    return true;
+}
+
+const StepTraceHeader& StepTraceReader::getHeader() const {
+    return this->header;
+}
+
+bool StepTraceReader::seek(const std::uint64_t step) {
+    if(step > this->header.numSteps)
+        return false;
+
+    /* Start from the last indexed record at or before the step, then skip whole runs up to it. */
+    std::uint64_t entry = 0;
+    std::uint64_t low = 0, high = this->index.size() / 2;
+    while(low < high) {
+        std::uint64_t mid = (low + high) / 2;
+        if(this->index[2 * mid] <= step) {
+            entry = mid;
+            low = mid + 1;
+        }
+        else
+            high = mid;
+    }
+    if(this->index.empty())
+        moveTo(StepTraceHeader::HEADER_SIZE, 0);
+    else
+        moveTo(this->index[2 * entry + 1], this->index[2 * entry]);
+
+    Step s;
+    std::uint64_t length;
+    while(this->position < step) {
+        if(!nextRun(s, length))
+            return false;
+
+        /* Keep the part of the run from the step onwards. */
+        if(this->position > step) {
+            this->pendingCode = static_cast<int>(s);
+            this->pendingLength = this->position - step;
+            this->position = step;
+        }
+    }
+    return true;
+}
+
+bool StepTraceReader::nextRun(Step& s, std::uint64_t& length) {
+    if(this->pendingCode < 0) {
+        if(this->pairedCode >= 0) {
+            this->pendingCode = this->pairedCode;
+            this->pendingLength = 1;
+            this->pairedCode = -1;
+        }
+        else if(!decodeRecord())
+            return false;
+    }
+
+    if(this->position + this->pendingLength > this->header.numSteps)
+        return false;
+    s = static_cast<Step>(this->pendingCode);
+    length = this->pendingLength;
+    this->position += length;
+    this->pendingCode = -1;
+    return true;
+}
+
+std::uint64_t StepTraceReader::readText(std::string& steps, const std::uint64_t count) {
+    std::uint64_t appended = 0;
+    Step s;
+    std::uint64_t length;
+    while(appended < count && nextRun(s, length)) {
+        std::uint64_t take = std::min(length, count - appended);
+        steps.append(take, STEP_CHARS[static_cast<int>(s)]);
+        appended += take;
+
+        /* Put back the part of the run past the count. */
+        if(take < length) {
+            this->pendingCode = static_cast<int>(s);
+            this->pendingLength = length - take;
+            this->position -= length - take;
+        }
+    }
+    return appended;
+}
+
+void StepTraceReader::moveTo(const std::uint64_t offset, const std::uint64_t step) {
+    this->in.clear();
+    this->in.seekg(offset);
+    this->offset = offset;
+    this->position = step;
+    this->pendingCode = -1;
+    this->pendingLength = 0;
+    this->pairedCode = -1;
+}
+
+bool StepTraceReader::decodeRecord() {
+    if(this->offset >= this->header.indexOffset)
+        return false;
+    int byte = this->in.get();
+    this->offset++;
+    if(byte == std::char_traits<char>::eof())
+        return false;
+
+    /* Two single steps, the second possibly padding. */
+    if(!(byte & 0x80)) {
+        int first = byte >> 4 & 7, second = byte >> 1 & 7;
+        if(first > MAX_CODE || (second > MAX_CODE && second != PAD_CODE))
+            return false;
+        this->pendingCode = first;
+        this->pendingLength = 1;
+        this->pairedCode = second == PAD_CODE ? -1 : second;
+        return true;
+    }
+
+    /* A run, with a varint extending its length if needed. */
+    int code = byte >> 4 & 7;
+    if(code > MAX_CODE)
+        return false;
+    std::uint64_t length = (byte & 15) + 3;
+    if((byte & 15) == 15) {
+        std::uint64_t rest = 0;
+        for(int shift = 0; ; shift += 7) {
+            if(shift > 63 || this->offset >= this->header.indexOffset)
+                return false;
+            int next = this->in.get();
+            this->offset++;
+            if(next == std::char_traits<char>::eof())
+                return false;
+            rest |= static_cast<std::uint64_t>(next & 0x7f) << shift;
+            if(!(next & 0x80))
+                break;
+        }
+        length = rest + 18;
+    }
+    this->pendingCode = code;
+    this->pendingLength = length;
+    return true;
+}
@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+
+namespace {
+    /* Pool and worker index of the worker running on this thread, if any. */
+    thread_local const void* currentPool = nullptr;
+    thread_local std::size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount) : nextQueue(0), queued(0), pending(0), stopping(false) {
+    /* hardware_concurrency() may report 0 when unknown. */
+    if(threadCount == 0)
+        threadCount = 1;
+
+    for(std::size_t i = 0; i < threadCount; i++)
+        this->queues.push_back(std::make_unique<WorkerQueue>());
+    for(std::size_t i = 0; i < threadCount; i++)
+        this->threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lk(this->stateLock);
+        this->stopping = true;
+    }
+    this->taskAvailable.notify_all();
+
+    for(std::thread& t : this->threads)
+        t.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    /* Tasks submitted by a worker stay on its own queue, others are spread round-robin. */
+    std::size_t index = currentPool == this ? currentWorker : this->nextQueue++ % this->queues.size();
+
+    {
+        std::lock_guard<std::mutex> lk(this->stateLock);
+        this->pending++;
+    }
+    {
+        std::lock_guard<std::mutex> lk(this->queues[index]->lock);
+        this->queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lk(this->stateLock);
+        this->queued++;
+    }
+    this->taskAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lk(this->stateLock);
+    this->allDone.wait(lk, [this] { return this->pending == 0; });
+}
+
+std::size_t ThreadPool::size() const {
+    return this->threads.size();
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    std::function<void()> task;
+    while(true) {
+        if(takeTask(index, task)) {
+            task();
+            task = nullptr;
+
+            std::lock_guard<std::mutex> lk(this->stateLock);
+            if(--this->pending == 0)
+                this->allDone.notify_all();
+            continue;
+        }
+
+        /* Nothing to run or steal, sleep until a task is queued. */
+        std::unique_lock<std::mutex> lk(this->stateLock);
+        this->taskAvailable.wait(lk, [this] { return this->queued > 0 || this->stopping; });
+        if(this->stopping && this->queued <= 0)
+            return;
+    }
+}
+
+bool ThreadPool::takeTask(std::size_t index, std::function<void()>& task) {
+    /* Own queue first, newest task first. */
+    {
+        WorkerQueue& own = *this->queues[index];
+        std::lock_guard<std::mutex> lk(own.lock);
+        if(!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            this->queued--;
+            return true;
+        }
+    }
+
+    /* Steal the oldest task of the next worker that has one. */
+    for(std::size_t i = 1; i < this->queues.size(); i++) {
+        WorkerQueue& victim = *this->queues[(index + i) % this->queues.size()];
+        std::lock_guard<std::mutex> lk(victim.lock);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            this->queued--;
+            return true;
+        }
+    }
+    return false;
+}
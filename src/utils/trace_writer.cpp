@@ -0,0 +1,35 @@
+#include "trace_writer.h"
+
+#include <cstdio>
+#include <fstream>
+
+void TraceWriter::complete(const char* name, const char* category, std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end, const int step, const int steps) {
+    std::int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - this->origin).count();
+    std::int64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    this->events.push_back(Event{name, category, startNs, durationNs, step, steps});
+}
+
+bool TraceWriter::write(const std::string traceFilePath) const {
+    std::ofstream f = std::ofstream(traceFilePath);
+    if(f.fail())
+        return false;
+
+    /* Timestamps are in microseconds, with nanosecond precision kept as decimals. Everything runs on one thread. */
+    f << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    char line[256];
+    for(size_t i = 0; i < this->events.size(); i++) {
+        const Event& e = this->events[i];
+        int length = std::snprintf(line, sizeof(line), "%s\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f",
+                                   i == 0 ? "" : ",", e.name, e.category, e.startNs / 1000.0, e.durationNs / 1000.0);
+        f.write(line, length);
+
+        if(e.step >= 0 && e.steps > 0)
+            f << ", \"args\": {\"step\": " << e.step << ", \"steps\": " << e.steps << "}";
+        else if(e.step >= 0)
+            f << ", \"args\": {\"step\": " << e.step << "}";
+        f << "}";
+    }
+    f << "\n]}\n";
+    return f.good();
+}